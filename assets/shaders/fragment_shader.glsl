@@ -1,20 +1,45 @@
 #version 330 core
 
+// Variants, defined by ShaderVariants:
+//   DEPTH_ONLY    writes nothing but depth, for the pre-pass
+//   FOG           fades into the sky with distance
+//   SHOW_NORMALS  debug view, faces colored by direction
+
 out vec4 FragColor;
 
-in vec2 texCoord;
+in vec3 texCoord;  // uv, atlas layer
+in vec3 tint;  // from the block registry, white when untinted
+in float viewDistance;
+#ifdef SHOW_NORMALS
+in vec3 normal;
+#endif
+
+uniform sampler2DArray ourTexture;
 
-uniform sampler2D ourTexture;
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    ivec4 cameraOrigin;
+    vec4 fogColor;
+    vec4 fogRange;  // x = start, y = end
+};
 
 void main()
 {
+#ifndef DEPTH_ONLY
+#ifdef SHOW_NORMALS
+    vec4 texColor = vec4(normal * 0.5 + 0.5, 1.0);
+#else
     vec4 texColor = texture(ourTexture, texCoord);
+    texColor.rgb *= tint;
+#endif
 
-    // Grass top tint: atlas cell (col=0, row=0) → u in [0, 1/16], v in [15/16, 1]
-    float cs = 1.0 / 16.0;
-    if (texCoord.x < cs && texCoord.y > 15.0 * cs) {
-        texColor.rgb *= vec3(0.72, 0.90, 0.50);
-    }
+#ifdef FOG
+    // same fog as the horizon, so the two meet without a seam
+    float fog = smoothstep(fogRange.x, fogRange.y, viewDistance);
+    texColor.rgb = mix(texColor.rgb, fogColor.rgb, fog);
+#endif
 
     FragColor = texColor;
-}
\ No newline at end of file
+#endif
+}
@@ -0,0 +1,36 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec3 relPos;
+in vec3 normal;
+
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;
+    ivec4 cameraOrigin;
+    vec4 fogColor;
+    vec4 fogRange;
+};
+
+uniform ivec4 innerBounds;  // world xz square drawn by finer geometry
+
+void main() {
+    // leave the middle to the finer level (or to the voxels)
+    vec4 inner = vec4(innerBounds - cameraOrigin.xzxz);
+    if (relPos.x > inner.x && relPos.x < inner.z &&
+        relPos.z > inner.y && relPos.z < inner.w) {
+        discard;
+    }
+
+    // flat grass on gentle slopes, stone on steep ones, like the voxels
+    vec3 n = normalize(normal);
+    vec3 grass = vec3(0.36, 0.58, 0.25);
+    vec3 stone = vec3(0.45, 0.45, 0.45);
+    vec3 color = mix(stone, grass, smoothstep(0.75, 0.9, n.y));
+    color *= 0.75 + 0.25 * max(dot(n, normalize(vec3(0.3, 1.0, 0.2))), 0.0);
+
+    float dist = length((view * vec4(relPos, 1.0)).xyz);
+    float fog = smoothstep(fogRange.x, fogRange.y, dist);
+    FragColor = vec4(mix(color, fogColor.rgb, fog), 1.0);
+}
@@ -0,0 +1,65 @@
+#version 330 core
+
+layout (location = 0) in ivec2 aGrid;
+
+out vec3 relPos;  // relative to cameraOrigin
+out vec3 normal;
+
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;  // relative to cameraOrigin
+    ivec4 cameraOrigin;
+    vec4 fogColor;
+    vec4 fogRange;  // x = start, y = end
+};
+
+uniform mat4 horizonProjection;  // own depth range, see main.cpp
+uniform sampler2DArray heights;
+uniform int level;
+uniform int spacing;
+uniform ivec2 origin;  // grid cell of vertex (0, 0)
+uniform int gridSize;
+
+float heightAt(ivec2 g) {
+    ivec2 cell = origin + g;
+    // toroidal addressing, the texture holds a scrolling window of cells
+    ivec2 texel = cell & (TEXTURE_SIZE - 1);  // TEXTURE_SIZE is injected
+    return texelFetch(heights, ivec3(texel, level), 0).r;
+}
+
+void main() {
+    float h = heightAt(aGrid);
+
+    // Morph toward the coarser level's surface near the edge so the seam
+    // between levels has no cracks: odd vertices slide onto the line between
+    // their even neighbors.
+    int center = gridSize / 2;
+    ivec2 d = abs(aGrid - ivec2(center));
+    float edge = float(max(d.x, d.y));
+    float morph = clamp((edge - float(center - 16)) / 12.0, 0.0, 1.0);
+    if (morph > 0.0) {
+        ivec2 even = aGrid & ~1;
+        ivec2 odd = aGrid & 1;
+        float coarse = mix(
+            mix(heightAt(even), heightAt(even + ivec2(2, 0)), 0.5 * odd.x),
+            mix(heightAt(even + ivec2(0, 2)), heightAt(even + ivec2(2, 2)), 0.5 * odd.x),
+            0.5 * odd.y);
+        h = mix(h, coarse, morph);
+    }
+
+    // central differences for lighting, clamped to the window
+    ivec2 lo = max(aGrid - 1, ivec2(0));
+    ivec2 hi = min(aGrid + 1, ivec2(gridSize - 1));
+    float hx = (heightAt(ivec2(hi.x, aGrid.y)) - heightAt(ivec2(lo.x, aGrid.y))) /
+               float(hi.x - lo.x);
+    float hz = (heightAt(ivec2(aGrid.x, hi.y)) - heightAt(ivec2(aGrid.x, lo.y))) /
+               float(hi.y - lo.y);
+    normal = normalize(vec3(-hx, float(spacing), -hz));
+
+    ivec2 world = (origin + aGrid) * spacing;
+    relPos = vec3(float(world.x - cameraOrigin.x), h - float(cameraOrigin.y),
+                  float(world.y - cameraOrigin.z));
+    // terrain tops out one block above the sampled height
+    relPos.y += 1.0;
+    gl_Position = horizonProjection * view * vec4(relPos, 1.0);
+}
@@ -0,0 +1,13 @@
+#version 330 core
+
+out vec4 FragColor;
+
+in vec4 color;
+in vec2 uv;
+
+// glyph coverage in red; rects sample a solid cell
+uniform sampler2D glyphs;
+
+void main() {
+    FragColor = vec4(color.rgb, color.a * texture(glyphs, uv).r);
+}
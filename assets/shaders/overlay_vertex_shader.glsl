@@ -0,0 +1,17 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;  // pixels from the top left
+layout (location = 1) in vec4 aColor;
+layout (location = 2) in vec2 aUV;   // into the glyph atlas
+
+out vec4 color;
+out vec2 uv;
+
+uniform vec2 screenSize;
+
+void main() {
+    vec2 ndc = aPos / screenSize * 2.0 - 1.0;
+    gl_Position = vec4(ndc.x, -ndc.y, 0.0, 1.0);
+    color = aColor;
+    uv = aUV;
+}
@@ -2,16 +2,40 @@
 
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoord;
+layout (location = 2) in vec3 aTexCoord;      // uv, atlas layer
+layout (location = 3) in ivec4 aChunkOrigin;  // per instance, w = cell size
+layout (location = 4) in uint aTint;          // block color, packed RGBA8
 
-out vec2 texCoord;
+// the depth pre-pass and the colour pass are separate programs drawing with
+// GL_LEQUAL, so both must compute exactly the same depth
+invariant gl_Position;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+out vec3 texCoord;
+out vec3 tint;
+out float viewDistance;
+#ifdef SHOW_NORMALS
+out vec3 normal;
+#endif
+
+// shared by all programs, see FrameUniforms in uniformBuffer.h
+layout (std140) uniform FrameData {
+    mat4 projection;
+    mat4 view;  // relative to cameraOrigin
+    ivec4 cameraOrigin;
+    vec4 fogColor;
+    vec4 fogRange;  // x = start, y = end
+};
 
 void main() {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
+    // integer subtraction first so large world coords don't lose precision
+    vec3 pos = vec3(aChunkOrigin.xyz - cameraOrigin.xyz) +
+               aPos * float(aChunkOrigin.w);
+    vec4 viewPos = view * vec4(pos, 1.0);
+    gl_Position = projection * viewPos;
+    viewDistance = length(viewPos.xyz);
     texCoord = aTexCoord;
+    tint = vec3(uvec3(aTint, aTint >> 8u, aTint >> 16u) & 0xFFu) / 255.0;
+#ifdef SHOW_NORMALS
+    normal = aNormal;
+#endif
 }
-
@@ -0,0 +1,365 @@
+// Microbenchmarks for the CPU hot paths in cubicum_core: noise, terrain
+// generation and chunk meshing. Everything uses fixed inputs (the noise
+// permutation is a constant table and chunk coordinates are hardcoded), so
+// numbers are comparable across commits on the same machine.
+//
+//   cubicum_bench [--filter <substring>] [--csv <path>]
+//
+// Each benchmark is run until it has taken at least MIN_RUN_MS, five times,
+// and the median run is reported. The mesher must not allocate once warmed
+// up; a mesh/ benchmark that does fails the run.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../src/world/chunkMesh.h"
+#include "../src/world/perlinNoise.h"
+#include "../src/world/terrain.h"
+
+// Every allocation in the process goes through here so a benchmark can
+// report how many it made per iteration. All forms of new and delete are
+// replaced, aligned and array ones included, and funnel into one counted
+// allocate/release pair. Those are kept out of line so the compiler never sees
+// a new-expression paired with free().
+static std::atomic<uint64_t> allocationCount{0};
+
+[[gnu::noinline]] static void* countedAllocate(std::size_t size,
+                                               std::size_t alignment) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (size == 0)
+    size = 1;
+  void* ptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    ptr = std::malloc(size);
+  } else {
+    // aligned_alloc wants the size to be a multiple of the alignment
+    ptr = std::aligned_alloc(alignment,
+                             (size + alignment - 1) / alignment * alignment);
+  }
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+[[gnu::noinline]] static void countedRelease(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void* operator new(std::size_t size) {
+  return countedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new[](std::size_t size) {
+  return countedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+  countedRelease(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+  countedRelease(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+  countedRelease(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+  countedRelease(ptr);
+}
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  countedRelease(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  countedRelease(ptr);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  countedRelease(ptr);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  countedRelease(ptr);
+}
+
+namespace {
+
+constexpr int CHUNK_SIZE = 16;
+constexpr int CHUNK_HEIGHT = 96;
+constexpr int REPEATS = 5;
+constexpr double MIN_RUN_MS = 200.0;
+
+// keeps the optimizer from dropping results
+volatile double sink;
+
+struct Result {
+  std::string name;
+  double nsPerIteration = 0.0;
+  double allocationsPerIteration = 0.0;
+  // optional per-iteration work, for derived rates
+  double voxels = 0.0;
+  double faces = 0.0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+// Runs body() `iterations` times and returns the elapsed ms.
+double timeIterations(const std::function<void()>& body, uint64_t iterations) {
+  const auto start = Clock::now();
+  for (uint64_t i = 0; i < iterations; i++)
+    body();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+Result run(const std::string& name,
+           const std::function<void()>& body,
+           double voxels = 0.0,
+           double faces = 0.0) {
+  // warm up (fills caches and scratch buffers) and pick an iteration count
+  body();
+  uint64_t iterations = 1;
+  while (timeIterations(body, iterations) < MIN_RUN_MS / 10.0)
+    iterations *= 2;
+  iterations *= 10;
+
+  std::vector<double> nsPerIteration;
+  uint64_t allocations = 0;
+  for (int repeat = 0; repeat < REPEATS; repeat++) {
+    const uint64_t before = allocationCount.load();
+    const double ms = timeIterations(body, iterations);
+    allocations += allocationCount.load() - before;
+    nsPerIteration.push_back(ms * 1e6 / iterations);
+  }
+  std::sort(nsPerIteration.begin(), nsPerIteration.end());
+
+  Result result;
+  result.name = name;
+  result.nsPerIteration = nsPerIteration[REPEATS / 2];
+  result.allocationsPerIteration =
+      static_cast<double>(allocations) / (iterations * REPEATS);
+  result.voxels = voxels;
+  result.faces = faces;
+  return result;
+}
+
+// block data in the layout Terrain produces: x + y*W + z*W*H
+std::vector<unsigned int> flatChunk(int surface) {
+  std::vector<unsigned int> data(CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT, 0);
+  for (int z = 0; z < CHUNK_SIZE; z++)
+    for (int y = 0; y <= surface; y++)
+      for (int x = 0; x < CHUNK_SIZE; x++)
+        data[x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_HEIGHT] =
+            y == surface ? 1 : 3;
+  return data;
+}
+
+// Worst case for the mesher: every other voxel is solid, so every solid
+// voxel shows all six faces.
+std::vector<unsigned int> checkerboardChunk() {
+  std::vector<unsigned int> data(CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT, 0);
+  for (int z = 0; z < CHUNK_SIZE; z++)
+    for (int y = 0; y < CHUNK_HEIGHT; y++)
+      for (int x = 0; x < CHUNK_SIZE; x++)
+        if ((x + y + z) % 2 == 0)
+          data[x + y * CHUNK_SIZE + z * CHUNK_SIZE * CHUNK_HEIGHT] = 3;
+  return data;
+}
+
+double faceCount(const ChunkMesh& mesh) {
+  return mesh.Indices().size() / 6.0;
+}
+
+void print(const Result& result) {
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-34s %12.1f ns %9.2f allocs",
+                result.name.c_str(), result.nsPerIteration,
+                result.allocationsPerIteration);
+  std::cout << line;
+  if (result.voxels > 0.0) {
+    std::snprintf(line, sizeof(line), " %8.2f ns/voxel",
+                  result.nsPerIteration / result.voxels);
+    std::cout << line;
+  }
+  if (result.faces > 0.0) {
+    std::snprintf(line, sizeof(line), " %8.2f Mfaces/s",
+                  result.faces / result.nsPerIteration * 1e3);
+    std::cout << line;
+  }
+  std::cout << "\n";
+}
+
+bool writeCsv(const std::string& path, const std::vector<Result>& results) {
+  std::ofstream file(path);
+  if (!file) {
+    std::cerr << "Failed to write benchmark CSV: " << path << " :c\n";
+    return false;
+  }
+  file << "name,ns_per_iteration,allocs_per_iteration,ns_per_voxel,"
+          "faces_per_second\n";
+  for (const Result& result : results) {
+    file << result.name << "," << result.nsPerIteration << ","
+         << result.allocationsPerIteration << ",";
+    if (result.voxels > 0.0)
+      file << result.nsPerIteration / result.voxels;
+    file << ",";
+    if (result.faces > 0.0)
+      file << result.faces / result.nsPerIteration * 1e9;
+    file << "\n";
+  }
+  std::cout << "Benchmark results written to " << path << "\n";
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string filter;
+  std::string csvPath;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+      csvPath = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--filter <substring>] [--csv <path>]\n";
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+  auto bench = [&](const std::string& name, const std::function<void()>& body,
+                   double voxels = 0.0, double faces = 0.0) {
+    if (!filter.empty() && name.find(filter) == std::string::npos)
+      return;
+    results.push_back(run(name, body, voxels, faces));
+    print(results.back());
+  };
+
+  const double chunkVoxels = CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT;
+
+  // noise, stepping through the plane so calls don't hit the same cell
+  {
+    double x = 0.0;
+    bench("noise/single", [&] {
+      sink = PerlinNoise::noise(x, 0.37, 0.0);
+      x += 0.173;
+    });
+  }
+  {
+    double x = 0.0;
+    bench("noise/7 octaves", [&] {
+      double h = 0.0, freq = 0.005, amp = 1.0;
+      for (int octave = 0; octave < 7; ++octave) {
+        h += amp * PerlinNoise::noise(x * freq, 0.37 * freq, 0.0);
+        freq *= 2.0;
+        amp *= 0.4;
+      }
+      sink = h;
+      x += 1.0;
+    });
+  }
+
+  // generation, walking along a row of chunks
+  Terrain terrain(CHUNK_SIZE, CHUNK_HEIGHT);
+  {
+    int chunkX = 1;
+    bench("terrain/GenerateChunkData", [&] {
+      sink = terrain.GenerateChunkData(chunkX++, 0, 7).size();
+    }, chunkVoxels);
+  }
+  {
+    int nodeX = 1;
+    bench("terrain/GenerateLodData level 2", [&] {
+      sink = terrain.GenerateLodData(2, nodeX++, 7).size();
+    }, CHUNK_SIZE * CHUNK_SIZE * (CHUNK_HEIGHT / 4));
+  }
+
+  // meshing one chunk of each kind, remeshed in place
+  const std::vector<unsigned int> flat = flatChunk(CHUNK_HEIGHT / 4);
+  const std::vector<unsigned int> hilly = terrain.GenerateChunkData(12, 0, 7);
+  const std::vector<unsigned int> checkerboard = checkerboardChunk();
+  struct MeshCase {
+    const char* name;
+    const std::vector<unsigned int>& data;
+  };
+  for (const MeshCase& meshCase : {MeshCase{"flat", flat},
+                                   MeshCase{"hilly", hilly},
+                                   MeshCase{"checkerboard", checkerboard}}) {
+    ChunkMesh mesh(CHUNK_SIZE, CHUNK_HEIGHT, meshCase.data);
+    bench(std::string("mesh/") + meshCase.name,
+          [&] { mesh.GenerateChunkMesh(); }, chunkVoxels, faceCount(mesh));
+  }
+
+  // neighbor rebuild: the same hilly chunk, culled against its four
+  // neighbors, which is what World does whenever a chunk streams in
+  {
+    const std::vector<unsigned int> negX = terrain.GenerateChunkData(11, 0, 7);
+    const std::vector<unsigned int> posX = terrain.GenerateChunkData(13, 0, 7);
+    const std::vector<unsigned int> negZ = terrain.GenerateChunkData(12, 0, 6);
+    const std::vector<unsigned int> posZ = terrain.GenerateChunkData(12, 0, 8);
+    ChunkMesh mesh(CHUNK_SIZE, CHUNK_HEIGHT, hilly);
+    mesh.GenerateChunkMesh(&negX, &posX, &negZ, &posZ);
+    bench("mesh/hilly with neighbors",
+          [&] { mesh.GenerateChunkMesh(&negX, &posX, &negZ, &posZ); },
+          chunkVoxels, faceCount(mesh));
+  }
+
+  // streaming: a row of chunks remeshed against their neighbors in turn, each
+  // mesh handed back after "upload" the way Chunk does
+  {
+    constexpr int ROW = 8;
+    std::vector<std::vector<unsigned int>> row;
+    for (int x = 0; x < ROW + 2; x++)
+      row.push_back(terrain.GenerateChunkData(20 + x, 0, 7));
+    std::vector<ChunkMesh> meshes;
+    meshes.reserve(ROW);
+    for (int i = 0; i < ROW; i++) {
+      meshes.emplace_back(CHUNK_SIZE, CHUNK_HEIGHT, row[i + 1]);
+      meshes.back().ReleaseMesh();
+    }
+    int next = 0;
+    bench("mesh/streaming remesh + release", [&] {
+      const int i = next++ % ROW;
+      meshes[i].GenerateChunkMesh(&row[i], &row[i + 2], nullptr, nullptr);
+      sink = meshes[i].Indices().size();
+      meshes[i].ReleaseMesh();
+    }, chunkVoxels);
+  }
+
+  // a whole new chunk: generate, copy into a ChunkMesh and mesh it
+  {
+    int chunkX = 1;
+    bench("chunk/generate + mesh", [&] {
+      ChunkMesh mesh(CHUNK_SIZE, CHUNK_HEIGHT,
+                     terrain.GenerateChunkData(chunkX++, 0, 7));
+      sink = mesh.Indices().size();
+    }, chunkVoxels);
+  }
+
+  if (!csvPath.empty() && !writeCsv(csvPath, results))
+    return 1;
+
+  bool allocationFree = true;
+  for (const Result& result : results) {
+    if (result.name.rfind("mesh/", 0) == 0 &&
+        result.allocationsPerIteration > 0.0) {
+      std::cerr << result.name << " allocates in steady state :c\n";
+      allocationFree = false;
+    }
+  }
+  return allocationFree ? 0 : 1;
+}
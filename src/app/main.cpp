@@ -0,0 +1,687 @@
+#include <glad/glad.h>
+
+#include <GLFW/glfw3.h>
+#include <stb_image.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../core/input_journal.h"
+#include "../core/memory_stats.h"
+#include "../core/path_manager.h"
+#include "../core/trace.h"
+#include "../render/camera.h"
+#include "../render/flythrough.h"
+#include "../render/glExtensions.h"
+#include "../render/gpuProfiler.h"
+#ifdef CUBICUM_HEADLESS
+#include "../render/headlessContext.h"
+#endif
+#include "../render/horizon.h"
+#include "../render/overdrawCounter.h"
+#include "../render/overlay.h"
+#include "../render/perfHud.h"
+#include "../render/renderDistanceController.h"
+#include "../render/shader.h"
+#include "../render/shaderVariants.h"
+#include "../render/textureArray.h"
+#include "../render/uniformBuffer.h"
+#include "../render/world.h"
+#include "../world/texture.h"
+
+// define  funcs
+
+void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn);
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
+void key_callback(GLFWwindow* window,
+                  int key,
+                  int scancode,
+                  int action,
+                  int mods);
+void processInput(GLFWwindow* window);
+
+// screen settings
+int width = 1920, height = 1080;
+
+// comera
+Camera camera(glm::vec3(0.0f, 50.0f, 50.0f));
+float lastX = width / 2.0f;
+float lastY = height / 2.0f;
+bool firstMouse = true;
+
+// keys held down, kept by key_callback so a replayed journal drives them too
+bool keysDown[GLFW_KEY_LAST + 1] = {};
+InputJournal inputJournal;
+
+// time
+float deltaTime = 0.0f;
+float lastFrame = 0.0f;
+
+// sky, also the fog color
+const glm::vec4 skyColor(0.455f, 0.701f, 1.0f, 0.8f);
+
+// debug toggles
+bool showHud = false;        // F3, frame times and engine counters
+bool depthPrepass = false;   // F5
+bool showOverdraw = false;   // F6
+bool adaptiveDistance = true;  // F7, render distance follows the frame time
+bool showNormals = false;    // F8
+bool showProfiler = false;   // F9, GPU pass timings
+bool dumpProfile = false;    // F10, writes them to a CSV
+bool dumpTrace = false;      // F11, CPU zones as Chrome trace JSON
+bool dumpMemory = false;     // F12, bytes per chunk as CSV
+
+// chunk shader variants, bit i is feature i given to chunkShaders
+enum ChunkShaderFeature : uint32_t {
+  CHUNK_DEPTH_ONLY = 1 << 0,
+  CHUNK_FOG = 1 << 1,
+  CHUNK_SHOW_NORMALS = 1 << 2,
+};
+
+// --bench-flythrough: the camera follows a recorded path at this fixed step
+const float FLYTHROUGH_STEP = 1.0f / 60.0f;
+
+// seconds since startup; GLFW's timer isn't available without a window
+double elapsedSeconds() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+void printUsage(const char* program) {
+  std::cout << "usage: " << program << " [options]\n"
+            << "  --bench-flythrough <path>  follow a recorded camera path, "
+               "then print frame stats\n"
+            << "  --headless                 no window, render offscreen "
+               "through EGL\n"
+            << "  --size <width>x<height>    window or framebuffer size\n"
+            << "  --frames <n>               stop after n frames\n"
+            << "  --dump-frames <dir>        headless: write frames as PNG\n"
+            << "  --dump-every <n>           headless: only every nth frame\n"
+            << "  --record-input <path>      journal this session's input\n"
+            << "  --replay-input <path>      play a journal back instead of "
+               "live input\n"
+            << "  --retain-meshes            keep CPU copies of chunk meshes "
+               "after upload\n";
+}
+
+int main(int argc, char** argv) {
+  // --bench-flythrough <path> replaces input with a recorded camera path and
+  // exits with frame time and streaming statistics when the path ends
+  std::string flythroughPath;
+  bool headless = false;
+  int frameLimit = -1;
+  std::string dumpDirectory;
+#ifdef CUBICUM_HEADLESS
+  int dumpEvery = 1;  // without headless support --dump-every is rejected
+#endif
+  std::string recordInputPath;
+  std::string replayInputPath;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--bench-flythrough" && hasValue) {
+      flythroughPath = argv[++i];
+    } else if (arg == "--headless") {
+      headless = true;
+    } else if (arg == "--size" && hasValue) {
+      if (std::sscanf(argv[++i], "%dx%d", &width, &height) != 2 ||
+          width <= 0 || height <= 0) {
+        printUsage(argv[0]);
+        return -1;
+      }
+    } else if (arg == "--frames" && hasValue) {
+      frameLimit = std::atoi(argv[++i]);
+    } else if (arg == "--dump-frames" && hasValue) {
+      dumpDirectory = argv[++i];
+#ifdef CUBICUM_HEADLESS
+    } else if (arg == "--dump-every" && hasValue) {
+      dumpEvery = std::max(std::atoi(argv[++i]), 1);
+#endif
+    } else if (arg == "--record-input" && hasValue) {
+      recordInputPath = argv[++i];
+    } else if (arg == "--replay-input" && hasValue) {
+      replayInputPath = argv[++i];
+    } else if (arg == "--retain-meshes") {
+      Chunk::SetRetainCpuMesh(true);
+    } else {
+      printUsage(argv[0]);
+      return -1;
+    }
+  }
+  const bool benchFlythrough = !flythroughPath.empty();
+  Flythrough flythrough;
+  FlythroughStats flythroughStats;
+  if (benchFlythrough && !flythrough.Load(flythroughPath))
+    return -1;
+
+  // a replay takes its input, frame times and render distance from the
+  // journal, so it ends up exactly where the recorded session did
+  const bool replayInput = !replayInputPath.empty();
+  if (replayInput && (benchFlythrough || !recordInputPath.empty())) {
+    std::cout << "--replay-input can't be combined with --bench-flythrough "
+                 "or --record-input :c\n";
+    return -1;
+  }
+  if (replayInput && !inputJournal.startReplay(replayInputPath))
+    return -1;
+  if (!recordInputPath.empty() &&
+      !inputJournal.startRecording(recordInputPath))
+    return -1;
+
+  // headless runs draw one frame unless told otherwise or following a path
+  // or a journal
+  if (headless && frameLimit < 0 && !benchFlythrough && !replayInput)
+    frameLimit = 1;
+
+  GLFWwindow* window = nullptr;
+  GLADloadproc loadProc = nullptr;
+#ifdef CUBICUM_HEADLESS
+  std::unique_ptr<HeadlessContext> headlessContext;
+#endif
+  if (headless) {
+#ifdef CUBICUM_HEADLESS
+    headlessContext = std::make_unique<HeadlessContext>(width, height);
+    if (!headlessContext->IsValid())
+      return -1;
+    loadProc = (GLADloadproc)HeadlessContext::GetProcAddress;
+#else
+    std::cout << "This build has no headless support (needs EGL) :c"
+              << std::endl;
+    return -1;
+#endif
+  } else {
+    // init glfw
+    if (!glfwInit()) {
+      std::cout << "Failed to initialize GLFW" << std::endl;
+      return -1;
+    }
+
+    // set opengl version :D
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    // create window
+    window = glfwCreateWindow(width, height, ":)", NULL, NULL);
+    if (window == NULL) {
+      std::cout << "Failed to create window :c" << std::endl;
+      glfwTerminate();
+      return -1;
+    }
+    glfwMakeContextCurrent(window);
+    loadProc = (GLADloadproc)glfwGetProcAddress;
+  }
+
+  // init GLAD
+  if (!gladLoadGLLoader(loadProc)) {
+    std::cout << "Failed to initialize GLAD :c" << std::endl;
+    return -1;
+  }
+  GLExtensions::load(loadProc);
+
+#ifdef CUBICUM_HEADLESS
+  if (headlessContext && !headlessContext->CreateFramebuffer())
+    return -1;
+#endif
+  if (!dumpDirectory.empty())
+    std::filesystem::create_directories(dumpDirectory);
+
+  // setup callbacks, the benchmark and replays take no live input
+  if (window) {
+    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    if (!benchFlythrough && !replayInput) {
+      glfwSetCursorPosCallback(window, mouse_callback);
+      glfwSetScrollCallback(window, scroll_callback);
+      glfwSetKeyCallback(window, key_callback);
+      glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    }
+  }
+  if (benchFlythrough) {
+    // same render distance and no vsync on every run, so builds compare
+    adaptiveDistance = false;
+    if (window)
+      glfwSwapInterval(0);
+  }
+  if (replayInput && window)
+    glfwSwapInterval(0);
+
+  // shader getpath & compile
+  std::string vertexShaderPath =
+      PathManager::getShaderPath("vertex_shader.glsl");
+  std::string fragmentShaderPath =
+      PathManager::getShaderPath("fragment_shader.glsl");
+
+  // chunk programs, one per variant actually drawn with
+  ShaderVariants chunkShaders(
+      vertexShaderPath, fragmentShaderPath,
+      {"DEPTH_ONLY", "FOG", "SHOW_NORMALS"}, [](Shader& program) {
+        program.useShader();
+        program.setInt("ourTexture", 0);
+        program.bindUniformBlock("FrameData", FRAME_UNIFORMS_BINDING);
+      });
+  chunkShaders.prepare({CHUNK_DEPTH_ONLY, CHUNK_FOG, CHUNK_SHOW_NORMALS});
+
+  // view/projection live in a UBO shared by all programs
+  UniformBuffer frameUniformBuffer(sizeof(FrameUniforms),
+                                   FRAME_UNIFORMS_BINDING);
+
+  // init world
+  World world;
+
+  // far terrain past the voxels
+  std::string horizonVertexShaderPath =
+      PathManager::getShaderPath("horizon_vertex_shader.glsl");
+  std::string horizonFragmentShaderPath =
+      PathManager::getShaderPath("horizon_fragment_shader.glsl");
+  Shader horizonShader(horizonVertexShaderPath.c_str(),
+                       horizonFragmentShaderPath.c_str(),
+                       Horizon::ShaderDefines());
+  horizonShader.bindUniformBlock("FrameData", FRAME_UNIFORMS_BINDING);
+
+  Horizon horizon(
+      [&world](float x, float z) { return world.TerrainHeight(x, z); }, 32);
+
+  // texture time! one array layer per atlas cell, baked by bake_textures
+  std::string terrainPath = PathManager::getTexturePath("terrain.png");
+  std::string bakedTerrainPath =
+      (PathManager::assetPath / "textures" / "terrain.ctex").string();
+  TextureArray terrainTextures(bakedTerrainPath, terrainPath, ATLAS_SIZE);
+
+  std::cout << "Texture setup complete\n";
+
+  glEnable(GL_DEPTH_TEST);
+
+  OverdrawCounter overdrawCounter;
+
+  // aim for 60 fps, anywhere between 2 and 12 chunks of full detail
+  RenderDistanceController distanceController(world.RenderDistance(), 2, 12);
+
+  // per-pass GPU times, drawn as bars over the frame
+  GpuProfiler gpuProfiler;
+  Overlay overlay;
+  Shader overlayShader(
+      PathManager::getShaderPath("overlay_vertex_shader.glsl").c_str(),
+      PathManager::getShaderPath("overlay_fragment_shader.glsl").c_str());
+
+  PerfHud perfHud;
+  bool hudShown = false;
+  Chunk::DrawStats drawStats;
+
+  std::cout << "About to enter main loop...\n";
+
+  // fps
+  double lastTime = elapsedSeconds();
+  int frameCount = 0;
+
+  int flythroughFrame = 0;
+  int frameNumber = 0;
+  float previousFrameStart = static_cast<float>(elapsedSeconds());
+  if (benchFlythrough) {
+    world.TrackLoadLatency(true);
+    std::cout << "Flythrough: " << flythroughPath << " ("
+              << flythrough.Duration() << " s)\n";
+  }
+
+  // main loop
+  std::cout << "Entering main loop\n";
+  TRACE_THREAD_NAME("main");
+  while (!(window && glfwWindowShouldClose(window))) {
+    if (frameLimit >= 0 && frameNumber >= frameLimit)
+      break;
+    TRACE_ZONE("frame");
+    float currentFrame = static_cast<float>(elapsedSeconds());
+    deltaTime = currentFrame - lastFrame;
+    if (replayInput) {
+      InputJournal::Frame frame;
+      if (!inputJournal.nextFrame(frame)) {
+        std::cout << "Replay finished after " << frameNumber << " frames\n";
+        break;
+      }
+      deltaTime = frame.deltaTime;
+      world.SetRenderDistance(frame.renderDistance);
+    } else {
+      inputJournal.recordFrame(
+          {currentFrame, deltaTime, world.RenderDistance()});
+    }
+    distanceController.BeginFrame();
+    gpuProfiler.BeginFrame();
+
+    // the HUD graph restarts whenever it is brought back up
+    if (showHud) {
+      if (!hudShown)
+        perfHud.Reset();
+      perfHud.AddFrame((currentFrame - previousFrameStart) * 1000.0f);
+      drawStats = {};
+    }
+    hudShown = showHud;
+    previousFrameStart = currentFrame;
+
+    // checkfps
+    double currentTime = elapsedSeconds();
+    frameCount++;
+    if (currentTime - lastTime >= 1.0f) {
+      std::cout << "FPS: " << frameCount << "\n";
+      if (adaptiveDistance)
+        std::cout << "Render distance: " << world.RenderDistance()
+                  << " (cpu " << distanceController.CpuFrameMs() << " ms, gpu "
+                  << distanceController.GpuFrameMs() << " ms)\n";
+      if (showOverdraw && overdrawCounter.HasResults()) {
+        double pixels = static_cast<double>(width) * height;
+        std::cout << "Overdraw: "
+                  << overdrawCounter.SamplesPassed() / pixels
+                  << " samples/px";
+        if (overdrawCounter.HasInvocations())
+          std::cout << ", " << overdrawCounter.FragmentInvocations() / pixels
+                    << " fragment invocations/px";
+        std::cout << (depthPrepass ? " (depth pre-pass)" : "") << "\n";
+      }
+      if (showProfiler) {
+        for (const GpuProfiler::PassStats& pass : gpuProfiler.Stats())
+          std::cout << "GPU " << pass.name << ": min " << pass.minMs
+                    << " / avg " << pass.avgMs << " / p99 " << pass.p99Ms
+                    << " ms\n";
+      }
+      frameCount = 0;
+      lastTime = currentTime;
+    }
+
+    // input, or the next step along the recorded path
+    if (benchFlythrough) {
+      float time = flythroughFrame * FLYTHROUGH_STEP;
+      if (time > flythrough.Duration())
+        break;
+      Flythrough::Keyframe key = flythrough.Sample(time);
+      camera.Position = key.position;
+      camera.SetOrientation(key.yaw, key.pitch);
+      flythroughFrame++;
+    } else {
+      processInput(window);
+    }
+
+    // rendering stuff
+    gpuProfiler.BeginPass("clear");
+    glClearColor(skyColor.r, skyColor.g, skyColor.b, skyColor.a);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    gpuProfiler.EndPass();
+
+    terrainTextures.Bind(0);
+
+    FrameUniforms frame;
+
+    // projection
+    frame.projection =
+        glm::perspective(glm::radians(camera.Zoom),
+                         (float)width / (float)height, 0.1f,
+                         world.ViewDistance());
+
+    // camera/view tranformation, relative to the block the camera is in
+    glm::ivec3 cameraOrigin = glm::ivec3(glm::floor(camera.Position));
+    frame.view = camera.GetViewMatrix(cameraOrigin);
+    frame.cameraOrigin = glm::ivec4(cameraOrigin, 0);
+
+    // fog starts inside the voxel area and ends at the horizon
+    frame.fogColor = skyColor;
+    frame.fogRange =
+        glm::vec4(world.ViewDistance() * 0.5f, horizon.Distance(), 0.0f, 0.0f);
+
+    // uniforms, new chunk meshes and horizon texels
+    gpuProfiler.BeginPass("upload");
+    frameUniformBuffer.update(&frame, sizeof(frame));
+
+    // update world
+    world.Update(camera.Position.x, camera.Position.y, camera.Position.z, 0);
+    static bool cameraPrinted = false;
+    if (!cameraPrinted) {
+      std::cout << "Camera at: (" << camera.Position.x << ", "
+                << camera.Position.y << ", " << camera.Position.z << ")\n";
+      cameraPrinted = true;
+    }
+    horizon.Update(camera.Position);
+    gpuProfiler.EndPass();
+
+    // Horizon first, in its own depth range. Everything it draws lies
+    // outside the voxel area, so the voxels can simply go on top after a
+    // depth clear and keep the precision of their own near/far planes.
+    gpuProfiler.BeginPass("horizon");
+    horizonShader.useShader();
+    horizonShader.setMat4(
+        "horizonProjection",
+        glm::perspective(glm::radians(camera.Zoom),
+                         (float)width / (float)height, 16.0f,
+                         horizon.Distance() * 1.5f));
+    horizon.Render(horizonShader, world.VoxelBounds());
+    glClear(GL_DEPTH_BUFFER_BIT);
+    gpuProfiler.EndPass();
+
+    // render world
+    if (showOverdraw)
+      overdrawCounter.Begin();
+
+    if (depthPrepass) {
+      // lay down depth first so the main pass shades each pixel once
+      gpuProfiler.BeginPass("depth prepass");
+      Shader& depthShader = chunkShaders.get(CHUNK_DEPTH_ONLY);
+      depthShader.useShader();
+      glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+      world.Render(camera.Position);
+      glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+      glDepthFunc(GL_LEQUAL);
+      glDepthMask(GL_FALSE);
+    }
+
+    gpuProfiler.BeginPass("terrain");
+    Shader& shader =
+        chunkShaders.get(showNormals ? CHUNK_SHOW_NORMALS : CHUNK_FOG);
+    shader.useShader();
+    world.Render(camera.Position, showHud ? &drawStats : nullptr);
+    gpuProfiler.EndPass();
+
+    if (depthPrepass) {
+      glDepthFunc(GL_LESS);
+      glDepthMask(GL_TRUE);
+    }
+
+    if (showOverdraw)
+      overdrawCounter.End();
+
+    if (showProfiler || showHud) {
+      gpuProfiler.BeginPass("overlay");
+      // 100 ms across, so a 60 fps budget is a sixth of the bar
+      if (showProfiler)
+        gpuProfiler.AddToOverlay(overlay, 16.0f, 16.0f, 300.0f, 100.0f);
+      if (showHud) {
+        PerfHud::Counters counters;
+        counters.cpuFrameMs = distanceController.CpuFrameMs();
+        counters.gpuFrameMs = distanceController.HasGpuTime()
+                                  ? distanceController.GpuFrameMs()
+                                  : -1.0f;
+        counters.renderDistance = world.RenderDistance();
+        counters.draws = drawStats;
+        counters.world = world.CollectStats();
+        perfHud.AddToOverlay(overlay, width - 16.0f, 16.0f, counters);
+      }
+      overlay.Draw(overlayShader, width, height);
+      gpuProfiler.EndPass();
+    }
+    gpuProfiler.EndFrame();
+    if (dumpProfile) {
+      std::string csvPath = PathManager::getCachePath("gpu_profile.csv");
+      if (gpuProfiler.WriteCsv(csvPath))
+        std::cout << "GPU profile written to " << csvPath << "\n";
+      dumpProfile = false;
+    }
+
+    // time spent before the swap, which may wait for vsync
+    float cpuFrameMs =
+        (static_cast<float>(elapsedSeconds()) - currentFrame) * 1000.0f;
+    distanceController.EndFrame(cpuFrameMs);
+    if (adaptiveDistance && !replayInput)
+      world.SetRenderDistance(distanceController.Distance());
+
+    if (dumpTrace) {
+      Trace::writeChromeJson(PathManager::getCachePath("trace.json"));
+      dumpTrace = false;
+    }
+    if (dumpMemory) {
+      std::string csvPath = PathManager::getCachePath("memory.csv");
+      if (world.WriteMemoryCsv(csvPath))
+        std::cout << "Per-chunk memory written to " << csvPath << "\n";
+      MemoryStats::print(std::cout);
+      dumpMemory = false;
+    }
+
+#ifdef CUBICUM_HEADLESS
+    if (headlessContext && !dumpDirectory.empty() &&
+        frameNumber % dumpEvery == 0) {
+      TRACE_ZONE("dump frame");
+      char name[32];
+      std::snprintf(name, sizeof(name), "frame_%05d.png", frameNumber);
+      headlessContext->SaveFrame(
+          (std::filesystem::path(dumpDirectory) / name).string());
+    }
+#endif
+    frameNumber++;
+
+    // call events and swap buffers
+    if (window) {
+      {
+        TRACE_ZONE("swap");
+        glfwSwapBuffers(window);
+      }
+      glfwPollEvents();
+    }
+    if (replayInput) {
+      inputJournal.dispatchEvents(
+          {[window](int key, int action, int mods) {
+             key_callback(window, key, 0, action, mods);
+           },
+           [window](double x, double y) { mouse_callback(window, x, y); },
+           [window](double x, double y) { scroll_callback(window, x, y); }});
+    }
+
+    if (benchFlythrough)
+      flythroughStats.AddFrame(
+          (static_cast<float>(elapsedSeconds()) - currentFrame) * 1000.0f);
+  }
+
+  // cleanup
+  if (window)
+    system("clear");
+  if (benchFlythrough)
+    flythroughStats.Print(std::cout, world.ChunkLoadLatencies(),
+                          world.LodLoadLatencies(), FLYTHROUGH_STEP * 1000.0f);
+  if (window)
+    glfwTerminate();
+  return 0;
+}
+
+// input func, window is null when headless
+void processInput(GLFWwindow* window) {
+  if (keysDown[GLFW_KEY_ESCAPE] && window) {
+    glfwSetWindowShouldClose(window, true);
+  }
+
+  if (keysDown[GLFW_KEY_W])
+    camera.ProcessKeyboard(camera.FORWARD, deltaTime);
+
+  if (keysDown[GLFW_KEY_S])
+    camera.ProcessKeyboard(camera.BACKWARD, deltaTime);
+
+  if (keysDown[GLFW_KEY_A])
+    camera.ProcessKeyboard(camera.LEFT, deltaTime);
+
+  if (keysDown[GLFW_KEY_D])
+    camera.ProcessKeyboard(camera.RIGHT, deltaTime);
+  if (keysDown[GLFW_KEY_SPACE])
+    camera.ProcessKeyboard(camera.UP, deltaTime);
+  if (keysDown[GLFW_KEY_LEFT_SHIFT])
+    camera.ProcessKeyboard(camera.DOWN, deltaTime);
+}
+
+// window func
+void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
+  glViewport(0, 0, width, height);
+}
+
+void mouse_callback(GLFWwindow* window, double xposIn, double yposIn) {
+  inputJournal.recordCursor(xposIn, yposIn);
+  float xpos = static_cast<float>(xposIn);
+  float ypos = static_cast<float>(yposIn);
+
+  if (firstMouse) {
+    lastX = xpos;
+    lastY = ypos;
+    firstMouse = false;
+  }
+
+  float xoffset = xpos - lastX;
+  float yoffset = lastY - ypos;
+  lastX = xpos;
+  lastY = ypos;
+
+  camera.ProcessMouseMovement(xoffset, yoffset, false);
+}
+
+void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+  inputJournal.recordScroll(xoffset, yoffset);
+  camera.ProcessMouseScroll(static_cast<float>(yoffset));
+}
+
+void key_callback(GLFWwindow* window,
+                  int key,
+                  int scancode,
+                  int action,
+                  int mods) {
+  inputJournal.recordKey(key, action, mods);
+  if (key >= 0 && key <= GLFW_KEY_LAST)
+    keysDown[key] = action != GLFW_RELEASE;
+  if (action != GLFW_PRESS)
+    return;
+
+  if (key == GLFW_KEY_F3) {
+    showHud = !showHud;
+    std::cout << "Performance HUD " << (showHud ? "on" : "off") << "\n";
+  }
+  if (key == GLFW_KEY_F5) {
+    depthPrepass = !depthPrepass;
+    std::cout << "Depth pre-pass " << (depthPrepass ? "on" : "off") << "\n";
+  }
+  if (key == GLFW_KEY_F6) {
+    showOverdraw = !showOverdraw;
+    std::cout << "Overdraw counter " << (showOverdraw ? "on" : "off") << "\n";
+  }
+  if (key == GLFW_KEY_F7) {
+    // off keeps whatever distance it had settled on
+    adaptiveDistance = !adaptiveDistance;
+    std::cout << "Adaptive render distance "
+              << (adaptiveDistance ? "on" : "off") << "\n";
+  }
+  if (key == GLFW_KEY_F8) {
+    showNormals = !showNormals;
+    std::cout << "Normals view " << (showNormals ? "on" : "off") << "\n";
+  }
+  if (key == GLFW_KEY_F9) {
+    showProfiler = !showProfiler;
+    std::cout << "GPU profiler overlay " << (showProfiler ? "on" : "off")
+              << "\n";
+  }
+  if (key == GLFW_KEY_F10)
+    dumpProfile = true;
+  if (key == GLFW_KEY_F11)
+    dumpTrace = true;
+  if (key == GLFW_KEY_F12)
+    dumpMemory = true;
+}
@@ -0,0 +1,130 @@
+#include "baked_texture.h"
+
+#include <algorithm>
+#include <cstring>
+
+static size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// 2x2 box filter, one layer
+static void downsample(const uint8_t* src,
+                       int srcWidth,
+                       int srcHeight,
+                       uint8_t* dst) {
+  const int dstWidth = std::max(srcWidth / 2, 1);
+  const int dstHeight = std::max(srcHeight / 2, 1);
+  for (int y = 0; y < dstHeight; y++) {
+    const int y0 = std::min(y * 2, srcHeight - 1);
+    const int y1 = std::min(y * 2 + 1, srcHeight - 1);
+    for (int x = 0; x < dstWidth; x++) {
+      const int x0 = std::min(x * 2, srcWidth - 1);
+      const int x1 = std::min(x * 2 + 1, srcWidth - 1);
+      for (int c = 0; c < 4; c++) {
+        int sum = src[(y0 * srcWidth + x0) * 4 + c] +
+                  src[(y0 * srcWidth + x1) * 4 + c] +
+                  src[(y1 * srcWidth + x0) * 4 + c] +
+                  src[(y1 * srcWidth + x1) * 4 + c];
+        dst[(y * dstWidth + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+      }
+    }
+  }
+}
+
+bool bakeAtlas(const uint8_t* rgba,
+               int width,
+               int height,
+               int cellsPerSide,
+               std::vector<uint8_t>& out) {
+  if (cellsPerSide <= 0 || width % cellsPerSide != 0 ||
+      height % cellsPerSide != 0)
+    return false;
+
+  const int cellWidth = width / cellsPerSide;
+  const int cellHeight = height / cellsPerSide;
+  const int layers = cellsPerSide * cellsPerSide;
+
+  int mipLevels = 1;
+  while ((std::max(cellWidth, cellHeight) >> mipLevels) > 0)
+    mipLevels++;
+
+  // lay out the file first so every level can be written in place
+  BakedTextureHeader header = {};
+  header.magic = BAKED_TEXTURE_MAGIC;
+  header.version = BAKED_TEXTURE_VERSION;
+  header.format = BAKED_FORMAT_RGBA8;
+  header.width = cellWidth;
+  header.height = cellHeight;
+  header.layers = layers;
+  header.mipLevels = mipLevels;
+
+  std::vector<BakedMip> mips(mipLevels);
+  size_t offset = sizeof(header) + sizeof(BakedMip) * mipLevels;
+  for (int level = 0; level < mipLevels; level++) {
+    const size_t levelWidth = std::max(cellWidth >> level, 1);
+    const size_t levelHeight = std::max(cellHeight >> level, 1);
+    offset = alignUp(offset, 16);
+    mips[level].offset = offset;
+    mips[level].size = levelWidth * levelHeight * 4 * layers;
+    offset += mips[level].size;
+  }
+
+  out.assign(offset, 0);
+  std::memcpy(out.data(), &header, sizeof(header));
+  std::memcpy(out.data() + sizeof(header), mips.data(),
+              sizeof(BakedMip) * mipLevels);
+
+  // level 0: cut the cells out, flipping each one so its bottom row is first
+  const size_t cellRowBytes = static_cast<size_t>(cellWidth) * 4;
+  uint8_t* dst = out.data() + mips[0].offset;
+  for (int row = 0; row < cellsPerSide; row++) {
+    for (int col = 0; col < cellsPerSide; col++) {
+      for (int line = cellHeight - 1; line >= 0; line--) {
+        const uint8_t* src =
+            rgba + (static_cast<size_t>(row * cellHeight + line) * width +
+                    static_cast<size_t>(col) * cellWidth) * 4;
+        std::memcpy(dst, src, cellRowBytes);
+        dst += cellRowBytes;
+      }
+    }
+  }
+
+  for (int level = 1; level < mipLevels; level++) {
+    const int srcWidth = std::max(cellWidth >> (level - 1), 1);
+    const int srcHeight = std::max(cellHeight >> (level - 1), 1);
+    const size_t srcLayerBytes = mips[level - 1].size / layers;
+    const size_t dstLayerBytes = mips[level].size / layers;
+    for (int layer = 0; layer < layers; layer++) {
+      downsample(out.data() + mips[level - 1].offset + srcLayerBytes * layer,
+                 srcWidth, srcHeight,
+                 out.data() + mips[level].offset + dstLayerBytes * layer);
+    }
+  }
+  return true;
+}
+
+const BakedTextureHeader* readBakedTexture(const uint8_t* data, size_t size) {
+  if (!data || size < sizeof(BakedTextureHeader))
+    return nullptr;
+
+  const BakedTextureHeader* header =
+      reinterpret_cast<const BakedTextureHeader*>(data);
+  if (header->magic != BAKED_TEXTURE_MAGIC ||
+      header->version != BAKED_TEXTURE_VERSION ||
+      header->format != BAKED_FORMAT_RGBA8 || header->mipLevels == 0 ||
+      header->mipLevels > 16 || header->layers == 0)
+    return nullptr;
+
+  if (size < sizeof(BakedTextureHeader) + sizeof(BakedMip) * header->mipLevels)
+    return nullptr;
+
+  const BakedMip* mips = bakedMips(header);
+  for (uint32_t level = 0; level < header->mipLevels; level++) {
+    const uint64_t levelWidth = std::max(header->width >> level, 1u);
+    const uint64_t levelHeight = std::max(header->height >> level, 1u);
+    if (mips[level].size != levelWidth * levelHeight * 4 * header->layers ||
+        mips[level].offset > size || mips[level].size > size - mips[level].offset)
+      return nullptr;
+  }
+  return header;
+}
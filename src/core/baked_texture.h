@@ -0,0 +1,59 @@
+#ifndef BAKED_TEXTURE_H
+#define BAKED_TEXTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Texture container written by the bake_textures tool. It holds a texture
+// array with its whole mip chain already laid out the way glTexImage3D takes
+// it, so loading is an mmap plus one upload per mip level:
+//
+//   BakedTextureHeader
+//   BakedMip[mipLevels]
+//   level data, 16-byte aligned, every layer of a level back to back
+//
+// Layer rows are stored bottom row first, matching GL's t = 0.
+
+constexpr uint32_t BAKED_TEXTURE_MAGIC = 0x58455443;  // "CTEX"
+constexpr uint32_t BAKED_TEXTURE_VERSION = 1;
+
+enum BakedTextureFormat : uint32_t {
+  BAKED_FORMAT_RGBA8 = 0,
+};
+
+struct BakedTextureHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t format;
+  uint32_t width;
+  uint32_t height;
+  uint32_t layers;
+  uint32_t mipLevels;
+  uint32_t reserved;
+};
+
+struct BakedMip {
+  uint64_t offset;  // from the start of the file
+  uint64_t size;
+};
+
+// Splits an RGBA8 atlas (top row first, as decoded from a PNG) into
+// cellsPerSide * cellsPerSide layers, layer = row * cellsPerSide + col, and
+// box-filters the mip chain down to 1x1. Returns false if the atlas doesn't
+// divide into whole cells.
+bool bakeAtlas(const uint8_t* rgba,
+               int width,
+               int height,
+               int cellsPerSide,
+               std::vector<uint8_t>& out);
+
+// Validates a container in memory. Returns its header, or nullptr if it is
+// truncated or not a container this build understands.
+const BakedTextureHeader* readBakedTexture(const uint8_t* data, size_t size);
+
+inline const BakedMip* bakedMips(const BakedTextureHeader* header) {
+  return reinterpret_cast<const BakedMip*>(header + 1);
+}
+
+#endif
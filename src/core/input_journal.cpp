@@ -0,0 +1,130 @@
+#include "input_journal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+constexpr uint32_t JOURNAL_MAGIC = 0x314A4943;  // "CIJ1"
+constexpr uint32_t JOURNAL_VERSION = 1;
+
+template <typename T>
+void InputJournal::write(T value) {
+  output.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool InputJournal::read(T& value) {
+  if (readOffset + sizeof(value) > input->size())
+    return false;
+  std::memcpy(&value, input->data() + readOffset, sizeof(value));
+  readOffset += sizeof(value);
+  return true;
+}
+
+bool InputJournal::startRecording(const std::string& path) {
+  output.open(path, std::ios::binary | std::ios::trunc);
+  if (!output) {
+    std::cerr << "Failed to create input journal: " << path << " :c\n";
+    return false;
+  }
+  write(JOURNAL_MAGIC);
+  write(JOURNAL_VERSION);
+  std::cout << "Recording input to " << path << "\n";
+  return true;
+}
+
+void InputJournal::recordFrame(const Frame& frame) {
+  if (!isRecording())
+    return;
+  write(EVENT_FRAME);
+  write(frame.time);
+  write(frame.deltaTime);
+  write(static_cast<uint8_t>(std::clamp(frame.renderDistance, 0, 255)));
+}
+
+void InputJournal::recordKey(int key, int action, int mods) {
+  if (!isRecording())
+    return;
+  write(EVENT_KEY);
+  write(static_cast<int16_t>(key));
+  write(static_cast<uint8_t>(action));
+  write(static_cast<uint8_t>(mods));
+}
+
+void InputJournal::recordCursor(double x, double y) {
+  if (!isRecording())
+    return;
+  write(EVENT_CURSOR);
+  write(static_cast<float>(x));
+  write(static_cast<float>(y));
+}
+
+void InputJournal::recordScroll(double x, double y) {
+  if (!isRecording())
+    return;
+  write(EVENT_SCROLL);
+  write(static_cast<float>(x));
+  write(static_cast<float>(y));
+}
+
+bool InputJournal::startReplay(const std::string& path) {
+  input = std::make_unique<MappedFile>(path);
+  uint32_t magic = 0, version = 0;
+  if (!input->isOpen() || !read(magic) || !read(version) ||
+      magic != JOURNAL_MAGIC || version != JOURNAL_VERSION) {
+    std::cerr << "Not an input journal: " << path << " :c\n";
+    input.reset();
+    return false;
+  }
+  std::cout << "Replaying input from " << path << "\n";
+  return true;
+}
+
+bool InputJournal::nextFrame(Frame& frame) {
+  if (!isReplaying())
+    return false;
+  // skip anything left over from the previous frame
+  dispatchEvents({});
+
+  uint8_t type = 0, renderDistance = 0;
+  if (!read(type) || type != EVENT_FRAME || !read(frame.time) ||
+      !read(frame.deltaTime) || !read(renderDistance))
+    return false;
+  frame.renderDistance = renderDistance;
+  return true;
+}
+
+void InputJournal::dispatchEvents(const Handlers& handlers) {
+  if (!isReplaying())
+    return;
+
+  while (readOffset < input->size()) {
+    const uint8_t type = input->data()[readOffset];
+    if (type == EVENT_FRAME)
+      return;
+    readOffset++;
+
+    if (type == EVENT_KEY) {
+      int16_t key;
+      uint8_t action, mods;
+      if (!read(key) || !read(action) || !read(mods))
+        break;
+      if (handlers.key)
+        handlers.key(key, action, mods);
+    } else if (type == EVENT_CURSOR || type == EVENT_SCROLL) {
+      float x, y;
+      if (!read(x) || !read(y))
+        break;
+      const auto& handler =
+          type == EVENT_CURSOR ? handlers.cursor : handlers.scroll;
+      if (handler)
+        handler(x, y);
+    } else {
+      std::cerr << "Corrupt input journal at byte " << readOffset - 1
+                << " :c\n";
+      break;
+    }
+  }
+  // truncated or corrupt: end the replay here
+  readOffset = input->size();
+}
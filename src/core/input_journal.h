@@ -0,0 +1,75 @@
+#ifndef INPUT_JOURNAL_H
+#define INPUT_JOURNAL_H
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "mapped_file.h"
+
+// Binary journal of a play session: one record per frame boundary, followed
+// by the key, cursor and scroll events delivered before the next frame.
+// Replaying hands the same events back at the same frames, and each frame
+// record also carries everything else that depends on wall time (the frame's
+// delta time and the render distance picked for it), so a replay drives the
+// camera and the world streaming exactly as the recorded session did.
+//
+//   "CIJ1" magic, uint32 version
+//   uint8 type, then per type:
+//     FRAME   float time, float deltaTime, uint8 renderDistance
+//     KEY     int16 key, uint8 action, uint8 mods
+//     CURSOR  float x, float y
+//     SCROLL  float x, float y
+//
+// Values are stored little-endian, as they are in memory on every platform
+// we build for.
+class InputJournal {
+ public:
+  struct Frame {
+    float time;       // seconds since startup when the frame began
+    float deltaTime;
+    int renderDistance;
+  };
+
+  struct Handlers {
+    std::function<void(int key, int action, int mods)> key;
+    std::function<void(double x, double y)> cursor;
+    std::function<void(double x, double y)> scroll;
+  };
+
+  bool startRecording(const std::string& path);
+  void recordFrame(const Frame& frame);
+  void recordKey(int key, int action, int mods);
+  void recordCursor(double x, double y);
+  void recordScroll(double x, double y);
+
+  bool startReplay(const std::string& path);
+  // Reads the next frame record; false once the journal is exhausted.
+  bool nextFrame(Frame& frame);
+  // Delivers the events recorded between the current frame and the next.
+  void dispatchEvents(const Handlers& handlers);
+
+  bool isRecording() const { return output.is_open(); }
+  bool isReplaying() const { return input != nullptr; }
+
+ private:
+  enum EventType : uint8_t {
+    EVENT_FRAME = 0,
+    EVENT_KEY = 1,
+    EVENT_CURSOR = 2,
+    EVENT_SCROLL = 3,
+  };
+
+  template <typename T>
+  void write(T value);
+  template <typename T>
+  bool read(T& value);
+
+  std::ofstream output;
+  std::unique_ptr<MappedFile> input;
+  size_t readOffset = 0;
+};
+
+#endif
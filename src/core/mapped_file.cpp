@@ -0,0 +1,51 @@
+#include "mapped_file.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#else
+#include <fstream>
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#ifdef HAVE_MMAP
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void* view =
+        mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+             fd, 0);
+    if (view != MAP_FAILED) {
+      bytes = static_cast<const uint8_t*>(view);
+      length = static_cast<size_t>(info.st_size);
+      mapped = true;
+    }
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return;
+  buffer.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (buffer.empty() ||
+      !file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+    return;
+  bytes = buffer.data();
+  length = buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef HAVE_MMAP
+  if (mapped)
+    munmap(const_cast<uint8_t*>(bytes), length);
+#endif
+}
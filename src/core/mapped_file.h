@@ -0,0 +1,31 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. Uses mmap where available, so the pages come
+// straight from the page cache instead of being copied into a buffer; other
+// platforms read the file into memory.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const { return bytes != nullptr; }
+  const uint8_t* data() const { return bytes; }
+  size_t size() const { return length; }
+
+ private:
+  const uint8_t* bytes = nullptr;
+  size_t length = 0;
+  bool mapped = false;
+  std::vector<uint8_t> buffer;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "memory_stats.h"
+
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+// constant-initialized, so trackers in other statics may still update them
+// during shutdown
+std::atomic<int64_t> currentBytes[MEMORY_CATEGORY_COUNT];
+std::atomic<int64_t> peakBytes[MEMORY_CATEGORY_COUNT];
+
+}  // namespace
+
+const char* MemoryStats::name(MemoryCategory category) {
+  switch (category) {
+    case MEMORY_VOXELS:
+      return "voxels";
+    case MEMORY_CPU_MESH:
+      return "mesh copies";
+    case MEMORY_GPU_MESH:
+      return "mesh buffers";
+    case MEMORY_STAGING:
+      return "staging";
+    case MEMORY_TEXTURES:
+      return "textures";
+    case MEMORY_CACHES:
+      return "caches";
+    default:
+      return "?";
+  }
+}
+
+bool MemoryStats::isGpu(MemoryCategory category) {
+  return category == MEMORY_GPU_MESH || category == MEMORY_STAGING ||
+         category == MEMORY_TEXTURES;
+}
+
+size_t MemoryStats::current(MemoryCategory category) {
+  return static_cast<size_t>(
+      currentBytes[category].load(std::memory_order_relaxed));
+}
+
+size_t MemoryStats::peak(MemoryCategory category) {
+  return static_cast<size_t>(peakBytes[category].load(std::memory_order_relaxed));
+}
+
+void MemoryStats::add(MemoryCategory category, int64_t delta) {
+  const int64_t now =
+      currentBytes[category].fetch_add(delta, std::memory_order_relaxed) +
+      delta;
+  int64_t peak = peakBytes[category].load(std::memory_order_relaxed);
+  while (now > peak && !peakBytes[category].compare_exchange_weak(
+                           peak, now, std::memory_order_relaxed)) {
+  }
+}
+
+void MemoryStats::print(std::ostream& out) {
+  char line[96];
+  for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+    const MemoryCategory category = static_cast<MemoryCategory>(i);
+    std::snprintf(line, sizeof(line), "%s %-12s %9.2f MB (peak %.2f MB)\n",
+                  isGpu(category) ? "GPU" : "CPU", name(category),
+                  current(category) / (1024.0 * 1024.0),
+                  peak(category) / (1024.0 * 1024.0));
+    out << line;
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Bytes held per subsystem, CPU heap and GPU storage alike. Owners keep a
+// MemoryTracker next to what they allocate and set it whenever that changes
+// size; the tracker keeps a process-wide total per category up to date and
+// hands its bytes back when it is destroyed.
+//
+//   MemoryTracker gpuMemory{MEMORY_GPU_MESH};
+//   ...
+//   gpuMemory.set(vboCapacity + eboCapacity);
+//
+// Totals are atomics, so trackers may live on any thread.
+enum MemoryCategory : uint8_t {
+  MEMORY_VOXELS,     // block data kept per chunk
+  MEMORY_CPU_MESH,   // vertices and indices kept after upload
+  MEMORY_GPU_MESH,   // vertex and index buffers
+  MEMORY_STAGING,    // upload ring
+  MEMORY_TEXTURES,
+  MEMORY_CACHES,     // scratch buffers and anything else kept for reuse
+  MEMORY_CATEGORY_COUNT
+};
+
+class MemoryStats {
+ public:
+  static const char* name(MemoryCategory category);
+  static bool isGpu(MemoryCategory category);
+
+  static size_t current(MemoryCategory category);
+  // highest current() seen since startup
+  static size_t peak(MemoryCategory category);
+
+  static void add(MemoryCategory category, int64_t delta);
+
+  // one line per category: name, CPU or GPU, current and peak
+  static void print(std::ostream& out);
+};
+
+class MemoryTracker {
+ public:
+  explicit MemoryTracker(MemoryCategory category) : category(category) {}
+  ~MemoryTracker() { set(0); }
+
+  // a copy owns a copy of the memory, so it counts it again
+  MemoryTracker(const MemoryTracker& other) : category(other.category) {
+    set(other.tracked);
+  }
+  MemoryTracker& operator=(const MemoryTracker& other) {
+    if (this != &other) {
+      set(0);
+      category = other.category;
+      set(other.tracked);
+    }
+    return *this;
+  }
+
+  void set(size_t bytes) {
+    if (bytes == tracked)
+      return;
+    MemoryStats::add(category,
+                     static_cast<int64_t>(bytes) - static_cast<int64_t>(tracked));
+    tracked = bytes;
+  }
+  size_t bytes() const { return tracked; }
+
+ private:
+  MemoryCategory category;
+  size_t tracked = 0;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include <iostream>
 
 const std::filesystem::path PathManager::assetPath = "../assets";
+const std::filesystem::path PathManager::cachePath = "../cache";
 
 std::string PathManager::getShaderPath(const std::string& shaderName) {
   std::filesystem::path shaderPath = (assetPath / "shaders" / shaderName);
@@ -23,4 +24,17 @@ std::string PathManager::getTexturePath(const std::string& textureName) {
   }
 
   return texturePath.string();
-}
\ No newline at end of file
+}
+
+std::string PathManager::getCachePath(const std::string& fileName) {
+  std::filesystem::path filePath = cachePath / fileName;
+
+  std::error_code error;
+  std::filesystem::create_directories(filePath.parent_path(), error);
+  if (error) {
+    std::cerr << "couldnt create cache directory " << filePath.parent_path()
+              << ": " << error.message() << std::endl;
+  }
+
+  return filePath.string();
+}
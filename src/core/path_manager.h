@@ -8,8 +8,11 @@ class PathManager {
  public:
   static std::string getShaderPath(const std::string& shaderName);
   static std::string getTexturePath(const std::string& textureName);
+  // files the game writes for itself; the directory is created on demand
+  static std::string getCachePath(const std::string& fileName);
 
   static const std::filesystem::path assetPath;
+  static const std::filesystem::path cachePath;
 };
 
 #endif
@@ -0,0 +1,181 @@
+#include "png_writer.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      t[n] = c;
+    }
+    return t;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++)
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+uint32_t adler32(const std::vector<uint8_t>& data) {
+  uint32_t a = 1, b = 0;
+  for (uint8_t byte : data) {
+    a = (a + byte) % 65521;
+    b = (b + a) % 65521;
+  }
+  return (b << 16) | a;
+}
+
+// LSB-first bit packer, as deflate wants it
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+  void bits(uint32_t value, int count) {
+    for (int i = 0; i < count; i++) {
+      current |= ((value >> i) & 1) << used;
+      if (++used == 8)
+        flush();
+    }
+  }
+
+  // Huffman codes are defined MSB first
+  void code(uint32_t value, int count) {
+    for (int i = count - 1; i >= 0; i--)
+      bits((value >> i) & 1, 1);
+  }
+
+  void flush() {
+    if (used == 0)
+      return;
+    out.push_back(current);
+    current = 0;
+    used = 0;
+  }
+
+ private:
+  std::vector<uint8_t>& out;
+  uint8_t current = 0;
+  int used = 0;
+};
+
+void fixedLiteral(BitWriter& writer, int symbol) {
+  if (symbol < 144)
+    writer.code(0x30 + symbol, 8);
+  else if (symbol < 256)
+    writer.code(0x190 + symbol - 144, 9);
+  else if (symbol < 280)
+    writer.code(symbol - 256, 7);
+  else
+    writer.code(0xC0 + symbol - 280, 8);
+}
+
+void fixedLength(BitWriter& writer, int length) {
+  static const int BASE[] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                             15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                             67, 83, 99, 115, 131, 163, 195, 227, 258};
+  static const int EXTRA[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                              2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  int code = 28;
+  while (BASE[code] > length)
+    code--;
+  fixedLiteral(writer, 257 + code);
+  writer.bits(length - BASE[code], EXTRA[code]);
+}
+
+// zlib stream: one final fixed-Huffman block, repeats of the previous byte
+// coded as distance-1 matches
+std::vector<uint8_t> deflate(const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> out = {0x78, 0x01};
+  BitWriter writer(out);
+  writer.bits(1, 1);  // BFINAL
+  writer.bits(1, 2);  // BTYPE = fixed Huffman
+
+  size_t i = 0;
+  while (i < data.size()) {
+    size_t run = 0;
+    if (i > 0) {
+      while (run < 258 && i + run < data.size() &&
+             data[i + run] == data[i - 1])
+        run++;
+    }
+    if (run >= 3) {
+      fixedLength(writer, static_cast<int>(run));
+      writer.code(0, 5);  // distance code 0 = 1
+      i += run;
+    } else {
+      fixedLiteral(writer, data[i]);
+      i++;
+    }
+  }
+  fixedLiteral(writer, 256);  // end of block
+  writer.flush();
+
+  const uint32_t adler = adler32(data);
+  for (int shift = 24; shift >= 0; shift -= 8)
+    out.push_back((adler >> shift) & 0xFF);
+  return out;
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8)
+    out.push_back((value >> shift) & 0xFF);
+}
+
+void chunk(std::vector<uint8_t>& png,
+           const char type[4],
+           const std::vector<uint8_t>& data) {
+  put32(png, static_cast<uint32_t>(data.size()));
+  const size_t start = png.size();
+  png.insert(png.end(), type, type + 4);
+  png.insert(png.end(), data.begin(), data.end());
+  put32(png, crc32(png.data() + start, png.size() - start));
+}
+
+}  // namespace
+
+bool writePng(const std::string& path,
+              uint32_t width,
+              uint32_t height,
+              const uint8_t* rgba) {
+  const size_t stride = static_cast<size_t>(width) * 4;
+
+  // filter byte + row, top row first, each row stored as its difference to
+  // the row above (filter type 2, Up)
+  std::vector<uint8_t> filtered;
+  filtered.reserve((stride + 1) * height);
+  for (uint32_t y = 0; y < height; y++) {
+    const uint8_t* row = rgba + (height - 1 - y) * stride;
+    const uint8_t* above = y > 0 ? row + stride : nullptr;
+    filtered.push_back(2);
+    for (size_t x = 0; x < stride; x++)
+      filtered.push_back(static_cast<uint8_t>(row[x] - (above ? above[x] : 0)));
+  }
+
+  std::vector<uint8_t> header;
+  put32(header, width);
+  put32(header, height);
+  header.insert(header.end(), {8, 6, 0, 0, 0});  // 8-bit RGBA, no interlace
+
+  static const uint8_t SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  std::vector<uint8_t> png(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+  chunk(png, "IHDR", header);
+  chunk(png, "IDAT", deflate(filtered));
+  chunk(png, "IEND", {});
+
+  std::ofstream file(path, std::ios::binary);
+  if (!file || !file.write(reinterpret_cast<const char*>(png.data()),
+                           png.size())) {
+    std::cerr << "Failed to write PNG: " << path << " :c\n";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,19 @@
+#ifndef PNG_WRITER_H
+#define PNG_WRITER_H
+
+#include <cstdint>
+#include <string>
+
+// Writes 8-bit RGBA pixels as a PNG. Rows are given bottom row first, the way
+// glReadPixels returns them, and flipped on the way out.
+//
+// The encoder is deliberately small: every row uses the Up filter and the
+// deflate stream only uses fixed Huffman codes with distance-1 runs. That is
+// enough to squeeze sky and other flat areas down, and keeps this free of a
+// zlib dependency.
+bool writePng(const std::string& path,
+              uint32_t width,
+              uint32_t height,
+              const uint8_t* rgba);
+
+#endif
@@ -0,0 +1,38 @@
+#include "scratch_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+void* ScratchArena::allocateBytes(size_t size, size_t alignment) {
+  if (!blocks.empty()) {
+    Block& block = blocks.back();
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    const size_t offset =
+        ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset + size <= block.size) {
+      used = offset + size;
+      return block.data.get() + offset;
+    }
+  }
+
+  // doesn't fit: chain a new block, at least as big as everything so far
+  const size_t blockSize =
+      std::max({size + alignment, Capacity(), MIN_BLOCK_SIZE});
+  blocks.push_back(
+      {std::make_unique_for_overwrite<std::byte[]>(blockSize), blockSize});
+  memory.set(Capacity() + blockSize);
+  used = 0;
+  return allocateBytes(size, alignment);
+}
+
+void ScratchArena::reset() {
+  used = 0;
+  if (blocks.size() <= 1)
+    return;
+  const size_t total = Capacity();
+  blocks.clear();
+  blocks.push_back(
+      {std::make_unique_for_overwrite<std::byte[]>(total), total});
+}
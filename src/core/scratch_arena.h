@@ -0,0 +1,54 @@
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "memory_stats.h"
+
+// Bump allocator for per-call scratch. Allocations are never freed one by
+// one; reset() drops all of them at once but keeps the memory, so after the
+// first few calls an arena is big enough and allocating from it never touches
+// the heap. Meant to be thread_local, one per thread and use.
+//
+//   static thread_local ScratchArena arena;
+//   arena.reset();
+//   uint8_t* mask = arena.allocate<uint8_t>(voxelCount);
+class ScratchArena {
+ public:
+  explicit ScratchArena(MemoryCategory category = MEMORY_CACHES)
+      : memory(category) {}
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // uninitialized storage for count Ts, valid until the next reset()
+  template <typename T>
+  T* allocate(size_t count) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "arena memory is dropped without running destructors");
+    return static_cast<T*>(allocateBytes(count * sizeof(T), alignof(T)));
+  }
+
+  // If the last round outgrew the first block, its blocks are merged into
+  // one that fits all of it.
+  void reset();
+
+  size_t Capacity() const { return memory.bytes(); }
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+
+  void* allocateBytes(size_t size, size_t alignment);
+
+  std::vector<Block> blocks;
+  size_t used = 0;  // in blocks.back()
+  MemoryTracker memory;
+};
+
+#endif
@@ -1,40 +0,0 @@
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <glad/glad.h>
-
-#include <filesystem>
-#include <glm/glm.hpp>
-#include <string>
-
-class Shader {
- public:
-  unsigned int shaderID;
-
-  Shader(const char* vertexSource, const char* fragmentSource);
-
-  void useShader();
-
-  void setBool(const std::string& name, bool value) const;
-  void setInt(const std::string& name, int value) const;
-  void setFloat(const std::string& name, float value) const;
-  void setVec2(const std::string& name, const glm::vec2& value) const;
-  void setVec2(const std::string& name, float x, float y) const;
-  void setVec3(const std::string& name, const glm::vec3& value) const;
-  void setVec3(const std::string& name, float x, float y, float z) const;
-  void setVec4(const std::string& name, const glm::vec4& value) const;
-  void setVec4(const std::string& name,
-               float x,
-               float y,
-               float z,
-               float w) const;
-
-  void setMat2(const std::string& name, const glm::mat2& mat) const;
-  void setMat3(const std::string& name, const glm::mat3& mat) const;
-  void setMat4(const std::string& name, const glm::mat4& mat) const;
-
- private:
-  void checkCompileErrors(GLuint shader, std::string type);
-};
-
-#endif
\ No newline at end of file
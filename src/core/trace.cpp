@@ -0,0 +1,134 @@
+#include "trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  uint64_t start;
+  uint64_t duration;
+};
+
+struct TraceBuffer {
+  int threadId;
+  std::string threadName;
+  std::vector<TraceEvent> events;
+  std::atomic<uint64_t> written{0};
+};
+
+// buffers live until exit so threads that ended still show up in the export
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+TraceBuffer& threadBuffer() {
+  thread_local TraceBuffer* buffer = nullptr;
+  if (!buffer) {
+    auto owned = std::make_unique<TraceBuffer>();
+    owned->events.resize(Trace::EVENTS_PER_THREAD);
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    owned->threadId = static_cast<int>(buffers.size()) + 1;
+    buffer = owned.get();
+    buffers.push_back(std::move(owned));
+  }
+  return *buffer;
+}
+
+#ifdef CUBICUM_TRACE
+void writeJsonString(std::ostream& out, const std::string& value) {
+  out << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out << '\\';
+    out << c;
+  }
+  out << '"';
+}
+
+// trace_event times are in microseconds, keep the ns as decimals
+void writeMicros(std::ostream& out, uint64_t ns) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%llu.%03llu",
+                static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned long long>(ns % 1000));
+  out << text;
+}
+#endif
+
+}  // namespace
+
+uint64_t Trace::now() {
+  static const auto epoch = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+void Trace::record(const char* name, uint64_t start, uint64_t end) {
+  TraceBuffer& buffer = threadBuffer();
+  uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  buffer.events[index % EVENTS_PER_THREAD] = {name, start, end - start};
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const char* name) {
+  TraceBuffer& buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(buffersMutex);
+  buffer.threadName = name;
+}
+
+bool Trace::writeChromeJson([[maybe_unused]] const std::string& path) {
+#ifdef CUBICUM_TRACE
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "couldnt write trace " << path << " :c" << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(buffersMutex);
+  file << "{\"traceEvents\":[\n";
+  bool first = true;
+  size_t eventCount = 0;
+  for (const std::unique_ptr<TraceBuffer>& buffer : buffers) {
+    if (!buffer->threadName.empty()) {
+      file << (first ? "" : ",\n")
+           << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":"
+           << buffer->threadId << ",\"args\":{\"name\":";
+      writeJsonString(file, buffer->threadName);
+      file << "}}";
+      first = false;
+    }
+
+    const uint64_t written = buffer->written.load(std::memory_order_acquire);
+    const uint64_t begin =
+        written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+    for (uint64_t i = begin; i < written; i++) {
+      const TraceEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+      file << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+      writeJsonString(file, event.name);
+      file << ",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+      writeMicros(file, event.start);
+      file << ",\"dur\":";
+      writeMicros(file, event.duration);
+      file << "}";
+      first = false;
+      eventCount++;
+    }
+  }
+  file << "\n]}\n";
+
+  std::cout << "Trace with " << eventCount << " events written to " << path
+            << "\n";
+  return static_cast<bool>(file);
+#else
+  std::cout << "tracing is compiled out of this build\n";
+  return false;
+#endif
+}
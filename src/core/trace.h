@@ -0,0 +1,58 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+#include <string>
+
+// Scoped CPU zones, exported as Chrome trace_event JSON (chrome://tracing or
+// ui.perfetto.dev). Every thread records into its own ring buffer, so a zone
+// costs two steady_clock reads and one store, with no locking; once a ring is
+// full the oldest events are overwritten.
+//
+//   void Chunk::GenerateChunkMesh() {
+//     TRACE_ZONE("Chunk::GenerateChunkMesh");
+//     ...
+//
+// Zones compile to nothing unless CUBICUM_TRACE is defined, which CMake does
+// for every build type except Release.
+
+class Trace {
+ public:
+  static constexpr size_t EVENTS_PER_THREAD = 1 << 16;
+
+  // ns since the first call
+  static uint64_t now();
+
+  // name must outlive the trace, i.e. be a string literal
+  static void record(const char* name, uint64_t start, uint64_t end);
+  static void setThreadName(const char* name);
+
+  // Writes every thread's ring. Meant to be called from a quiet point, other
+  // threads still recording may tear their newest events.
+  static bool writeChromeJson(const std::string& path);
+};
+
+class TraceZone {
+ public:
+  explicit TraceZone(const char* name) : name(name), start(Trace::now()) {}
+  ~TraceZone() { Trace::record(name, start, Trace::now()); }
+
+  TraceZone(const TraceZone&) = delete;
+  TraceZone& operator=(const TraceZone&) = delete;
+
+ private:
+  const char* name;
+  uint64_t start;
+};
+
+#ifdef CUBICUM_TRACE
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
+
+#endif
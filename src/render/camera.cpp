@@ -45,6 +45,11 @@ glm::mat4 Camera::GetViewMatrix() {
   return glm::lookAt(Position, Position + Front, Up);
 }
 
+glm::mat4 Camera::GetViewMatrix(const glm::ivec3& origin) {
+  glm::vec3 relative = Position - glm::vec3(origin);
+  return glm::lookAt(relative, relative + Front, Up);
+}
+
 void Camera::ProcessKeyboard(Camera_Movement direction, float deltaTime) {
   float velocity = MovementSpeed * deltaTime;
   if (direction == FORWARD)
@@ -62,6 +67,12 @@ void Camera::ProcessKeyboard(Camera_Movement direction, float deltaTime) {
     Position -= WorldUp * velocity;
 }
 
+void Camera::SetOrientation(float yaw, float pitch) {
+  Yaw = yaw;
+  Pitch = pitch;
+  updateCameraVectors();
+}
+
 void Camera::ProcessMouseMovement(float xoffset,
                                   float yoffset,
                                   GLboolean constrainPitch) {
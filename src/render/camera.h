@@ -46,6 +46,9 @@ class Camera {
          float pitch);
 
   glm::mat4 GetViewMatrix();
+  // view matrix with the camera expressed relative to an integer origin, so
+  // far-from-zero world coordinates keep their float precision
+  glm::mat4 GetViewMatrix(const glm::ivec3& origin);
 
   void ProcessKeyboard(Camera_Movement direction, float deltaTime);
   void ProcessMouseMovement(float xoffset,
@@ -53,6 +56,9 @@ class Camera {
                             GLboolean constrainPitch);
   void ProcessMouseScroll(float yoffset);
 
+  // points the camera directly, in degrees
+  void SetOrientation(float yaw, float pitch);
+
  private:
   void updateCameraVectors();
 };
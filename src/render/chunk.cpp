@@ -1,29 +1,28 @@
 #include "chunk.h"
-#include "texture.h"
+#include "../core/trace.h"
+#include "stagingRing.h"
 
 #include <GLFW/glfw3.h>
 #include <cstdint>
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 
-#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
 Chunk::Chunk(unsigned int chunkWidth,
              unsigned int chunkHeight,
              const std::vector<unsigned int>& chunkData,
-             const glm::vec3& position)
-    : chunkWidth(chunkWidth),
-      chunkHeight(chunkHeight),
-      position(position),
-      chunkData(chunkData) {
-      blocks.resize(chunkWidth,
-              std::vector<std::vector<uint8_t>>(
-                  chunkHeight, std::vector<uint8_t>(chunkWidth, 0)));
-
-
-  GenerateChunkTerrain();
+             const glm::vec3& position,
+             StagingRing* stagingRing,
+             unsigned int scale)
+    : position(position),
+      scale(scale),
+      mesh(chunkWidth, chunkHeight, chunkData),
+      stagingRing(stagingRing) {
+  SetupBuffers();
 }
 
 Chunk::~Chunk() {
@@ -35,217 +34,73 @@ Chunk::~Chunk() {
     glDeleteBuffers(1, &ebo);
 }
 
-void Chunk::GenerateChunkTerrain() {
-  auto start = std::chrono::high_resolution_clock::now();
-  // Use chunkData from constructor (already populated with heightmap values)
-  for (int x = 0; x < chunkWidth; x++) {
-    for (int y = 0; y < chunkHeight; y++) {
-      for (int z = 0; z < chunkWidth; z++) {
-        int index = x + y * chunkWidth + z * chunkWidth * chunkHeight;
-        blocks[x][y][z] = static_cast<uint8_t>(chunkData[index]);
-      }
-    }
-  }
-  GenerateChunkMesh();  // no neighbors yet on first build
-  SetupBuffers();
-  auto end = std::chrono::high_resolution_clock::now();
-  auto duration =
-      std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-  std::cout << "Chunk creation time: " << duration.count() << "[ms]" << "\n";
-}
-
-// Returns whether a block at neighbor-chunk local coords is solid.
-// neighborData is the flat data array of the adjacent chunk (may be nullptr).
-static bool neighborSolid(const std::vector<unsigned int>* neighborData,
-                           int nx, int ny, int nz,
-                           int W, int H) {
-  if (!neighborData) return false;  // no neighbor → treat as air → show face
-  if (ny < 0 || ny >= H) return false;
-  int idx = nx + ny * W + nz * W * H;
-  return (*neighborData)[idx] != 0;
-}
-
-void Chunk::GenerateChunkMesh(
+void Chunk::RebuildMesh(
     const std::vector<unsigned int>* negX,
     const std::vector<unsigned int>* posX,
     const std::vector<unsigned int>* negZ,
     const std::vector<unsigned int>* posZ) {
-  vertices.clear();
-  indices.clear();
-  unsigned int indexOffset = 0;
-
-  const int W = static_cast<int>(chunkWidth);
-  const int H = static_cast<int>(chunkHeight);
-
-  for (int x = 0; x < W; x++) {
-    for (int y = 0; y < H; y++) {
-      for (int z = 0; z < W; z++) {
-        if (!blocks[x][y][z])
-          continue;
-
-        // For border faces, look up the neighboring chunk's block instead of assuming air.
-        bool top    = (y == H-1) || !blocks[x][y+1][z];
-        bool bottom = (y == 0)   || !blocks[x][y-1][z];
-
-        bool front = (z == W-1) ? !neighborSolid(posZ, x, y, 0,   W, H)
-                                : !blocks[x][y][z+1];
-        bool back  = (z == 0)   ? !neighborSolid(negZ, x, y, W-1, W, H)
-                                : !blocks[x][y][z-1];
-        bool left  = (x == 0)   ? !neighborSolid(negX, W-1, y, z, W, H)
-                                : !blocks[x-1][y][z];
-        bool right = (x == W-1) ? !neighborSolid(posX, 0,   y, z, W, H)
-                                : !blocks[x+1][y][z];
-
-        if (!top && !bottom && !front && !back && !left && !right) {
-          continue;
-        }
-        uint8_t blockType = blocks[x][y][z];
+  mesh.GenerateChunkMesh(negX, posX, negZ, posZ);
+  UploadMesh();
+}
 
-        // add visible faces
-        if (top) {
-          auto [col, row] = getAtlasCell(blockType, true, false);
-          AddFace(x, y, z, glm::vec3(0, 1, 0), indexOffset, col, row);
-        }
-        if (bottom) {
-          auto [col, row] = getAtlasCell(blockType, false, true);
-          AddFace(x, y, z, glm::vec3(0, -1, 0), indexOffset, col, row);
-        }
-        if (front) {
-          auto [col, row] = getAtlasCell(blockType, false, false);
-          AddFace(x, y, z, glm::vec3(0, 0, 1), indexOffset, col, row);
-        }
-        if (back) {
-          auto [col, row] = getAtlasCell(blockType, false, false);
-          AddFace(x, y, z, glm::vec3(0, 0, -1), indexOffset, col, row);
-        }
-        if (left) {
-          auto [col, row] = getAtlasCell(blockType, false, false);
-          AddFace(x, y, z, glm::vec3(-1, 0, 0), indexOffset, col, row);
-        }
-        if (right) {
-          auto [col, row] = getAtlasCell(blockType, false, false);
-          AddFace(x, y, z, glm::vec3(1, 0, 0), indexOffset, col, row);
-        }
-      }
-    }
-  }
+void Chunk::UploadMesh() {
+  TRACE_ZONE("Chunk::UploadMesh");
+  const std::vector<ChunkMesh::Vertex>& vertices = mesh.Vertices();
+  const std::vector<unsigned int>& indices = mesh.Indices();
   numIndices = indices.size();
+  const int32_t origin[4] = {static_cast<int32_t>(position.x),
+                             static_cast<int32_t>(position.y),
+                             static_cast<int32_t>(position.z),
+                             static_cast<int32_t>(scale)};
+  UploadBuffer(vbo, vboCapacity, origin, ORIGIN_HEADER_BYTES, vertices.data(),
+               vertices.size() * sizeof(ChunkMesh::Vertex));
+  UploadBuffer(ebo, eboCapacity, nullptr, 0, indices.data(),
+               indices.size() * sizeof(unsigned int));
+  gpuMemory.set(vboCapacity + eboCapacity);
+
+  // both paths copy the data out before returning, nothing reads it again
+  if (!retainCpuMesh)
+    mesh.ReleaseMesh();
 }
 
-void Chunk::AddFace(int x,
-                    int y,
-                    int z,
-                    glm::vec3 normal,
-                    unsigned int& indexOffset,
-                    int atlasCol,
-                    int atlasRow) {
-  // Convert atlas cell (col, row) to UV coordinates in [0,1] space.
-  // Each cell occupies 1/ATLAS_SIZE of the texture in each axis.
-  const float cs = 1.0f / static_cast<float>(ATLAS_SIZE);
-  float u0 = atlasCol * cs;
-  float u1 = (atlasCol + 1) * cs;
-  // V is flipped because stbi_set_flip_vertically_on_load(true) makes row 0 of PNG → v=1.0
-  float v1 = 1.0f - atlasRow * cs;
-  float v0 = 1.0f - (atlasRow + 1) * cs;
-
-  glm::vec3 v1p, v2p, v3p, v4p;
-
-  if (normal == glm::vec3(0, 1, 0)) {
-    v1p = glm::vec3(x, y + 1, z);
-    v2p = glm::vec3(x + 1, y + 1, z);
-    v3p = glm::vec3(x + 1, y + 1, z + 1);
-    v4p = glm::vec3(x, y + 1, z + 1);
-
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v0});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v1});
-  }
-  if (normal == glm::vec3(0, -1, 0)) {
-    v1p = glm::vec3(x, y, z);
-    v2p = glm::vec3(x + 1, y, z);
-    v3p = glm::vec3(x + 1, y, z + 1);
-    v4p = glm::vec3(x, y, z + 1);
-
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v1});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v0});
-  }
-  if (normal == glm::vec3(0, 0, 1)) {
-    v1p = glm::vec3(x + 1, y, z + 1);
-    v2p = glm::vec3(x, y, z + 1);
-    v3p = glm::vec3(x, y + 1, z + 1);
-    v4p = glm::vec3(x + 1, y + 1, z + 1);
-
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v0});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v1});
-  }
-  if (normal == glm::vec3(0, 0, -1)) {
-    v1p = glm::vec3(x, y, z);
-    v2p = glm::vec3(x + 1, y, z);
-    v3p = glm::vec3(x + 1, y + 1, z);
-    v4p = glm::vec3(x, y + 1, z);
-
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v0});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v1});
-  }
-  if (normal == glm::vec3(-1, 0, 0)) {
-    v1p = glm::vec3(x, y, z);
-    v2p = glm::vec3(x, y, z + 1);
-    v3p = glm::vec3(x, y + 1, z + 1);
-    v4p = glm::vec3(x, y + 1, z);
-
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v0});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v1});
+// Streams header + data into buffer through the staging ring. Storage is only
+// reallocated when the mesh grows past the current capacity, with some
+// headroom so small remeshes don't trigger another reallocation.
+void Chunk::UploadBuffer(GLuint buffer,
+                         GLsizeiptr& capacity,
+                         const void* header,
+                         GLsizeiptr headerSize,
+                         const void* data,
+                         GLsizeiptr dataSize) {
+  const GLsizeiptr size = headerSize + dataSize;
+  if (size == 0)
+    return;
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+  if (size > capacity) {
+    capacity = size + size / 4;
+    glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_STATIC_DRAW);
   }
-  if (normal == glm::vec3(1, 0, 0)) {
-    v1p = glm::vec3(x + 1, y, z + 1);
-    v2p = glm::vec3(x + 1, y, z);
-    v3p = glm::vec3(x + 1, y + 1, z);
-    v4p = glm::vec3(x + 1, y + 1, z + 1);
 
-    vertices.insert(vertices.end(), {v1p.x, v1p.y, v1p.z, normal.x, normal.y, normal.z, u0, v0});
-    vertices.insert(vertices.end(), {v2p.x, v2p.y, v2p.z, normal.x, normal.y, normal.z, u1, v0});
-    vertices.insert(vertices.end(), {v3p.x, v3p.y, v3p.z, normal.x, normal.y, normal.z, u1, v1});
-    vertices.insert(vertices.end(), {v4p.x, v4p.y, v4p.z, normal.x, normal.y, normal.z, u0, v1});
+  StagingRing::Allocation alloc;
+  if (stagingRing)
+    alloc = stagingRing->Allocate(size);
+
+  if (alloc.ptr) {
+    if (headerSize > 0)
+      std::memcpy(alloc.ptr, header, headerSize);
+    if (dataSize > 0)
+      std::memcpy(alloc.ptr + headerSize, data, dataSize);
+    stagingRing->Submit(alloc, buffer, 0);
+  } else {
+    // no ring or mesh larger than the ring
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    if (headerSize > 0)
+      glBufferSubData(GL_COPY_WRITE_BUFFER, 0, headerSize, header);
+    if (dataSize > 0)
+      glBufferSubData(GL_COPY_WRITE_BUFFER, headerSize, dataSize, data);
   }
-
-  indices.push_back(indexOffset);
-  indices.push_back(indexOffset + 1);
-  indices.push_back(indexOffset + 2);
-  indices.push_back(indexOffset + 2);
-  indices.push_back(indexOffset + 3);
-  indices.push_back(indexOffset);
-
-  indexOffset += 4;
-}
-
-void Chunk::RebuildMesh(
-    const std::vector<unsigned int>* negX,
-    const std::vector<unsigned int>* posX,
-    const std::vector<unsigned int>* negZ,
-    const std::vector<unsigned int>* posZ) {
-  GenerateChunkMesh(negX, posX, negZ, posZ);
-
-  // Update existing GPU buffers without allocating new ones.
-  glBindVertexArray(vao);
-
-  glBindBuffer(GL_ARRAY_BUFFER, vbo);
-  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
-               vertices.data(), GL_STATIC_DRAW);
-
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
-               indices.data(), GL_STATIC_DRAW);
-
-  glBindVertexArray(0);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
 
 void Chunk::SetupBuffers() {
@@ -253,32 +108,94 @@ void Chunk::SetupBuffers() {
   glGenBuffers(1, &vbo);
   glGenBuffers(1, &ebo);
 
+  UploadMesh();
+
   glBindVertexArray(vao);
 
   glBindBuffer(GL_ARRAY_BUFFER, vbo);
-  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
-               vertices.data(), GL_STATIC_DRAW);
-
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
-               indices.data(), GL_STATIC_DRAW);
 
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+  const GLsizeiptr base = ORIGIN_HEADER_BYTES;
+
+  using Vertex = ChunkMesh::Vertex;
+  const GLsizei stride = sizeof(Vertex);
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void*)(base + offsetof(Vertex, position)));
   glEnableVertexAttribArray(0);
 
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                        (void*)(3 * sizeof(float)));
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void*)(base + offsetof(Vertex, normal)));
   glEnableVertexAttribArray(1);
 
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float),
-                        (void*)(6 * sizeof(float)));
+  // uv + texture array layer
+  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void*)(base + offsetof(Vertex, uvLayer)));
   glEnableVertexAttribArray(2);
 
+  // per-block color multiplier, packed RGBA8 unpacked in the shader
+  glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, stride,
+                         (void*)(base + offsetof(Vertex, tint)));
+  glEnableVertexAttribArray(4);
+
+  // chunk origin + scale: one value per instance, read from the VBO header
+  glVertexAttribIPointer(3, 4, GL_INT, 0, (void*)0);
+  glVertexAttribDivisor(3, 1);
+  glEnableVertexAttribArray(3);
+
   glBindVertexArray(0);
 }
 
-void Chunk::Render(const glm::mat4& modelMatrix) {
+void Chunk::Render(const glm::vec3& cameraPos, DrawStats* stats) {
+  TRACE_ZONE("Chunk::Render");
+  if (numIndices == 0)
+    return;
+
+  // A face with normal +X at plane x is only front-facing when the camera is
+  // past that plane. The lowest such plane in the chunk is just above its min
+  // corner, so the whole +X bucket is hidden while the camera is at or below
+  // min.x, and likewise for the other five directions.
+  const glm::vec3 boundsMin = position;
+  const glm::vec3 boundsMax = position + Extent();
+  const bool visible[FACE_COUNT] = {
+      cameraPos.x > boundsMin.x, cameraPos.x < boundsMax.x,
+      cameraPos.y > boundsMin.y, cameraPos.y < boundsMax.y,
+      cameraPos.z > boundsMin.z, cameraPos.z < boundsMax.z};
+
+  // merge adjacent visible buckets into single ranges
+  GLsizei counts[FACE_COUNT];
+  const void* offsets[FACE_COUNT];
+  GLsizei drawCount = 0;
+  bool extend = false;
+  for (int face = 0; face < FACE_COUNT; face++) {
+    const ChunkMesh::FaceBucket& bucket = mesh.Buckets()[face];
+    if (!visible[face] || bucket.indexCount == 0) {
+      extend = false;
+      continue;
+    }
+    if (extend) {
+      counts[drawCount - 1] += bucket.indexCount;
+    } else {
+      counts[drawCount] = bucket.indexCount;
+      offsets[drawCount] =
+          (const void*)(bucket.firstIndex * sizeof(unsigned int));
+      drawCount++;
+    }
+    extend = true;
+  }
+  if (drawCount == 0)
+    return;
+
+  // non-instanced draws read the per-instance origin attribute at instance 0
   glBindVertexArray(vao);
-  glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, 0);
+  glMultiDrawElements(GL_TRIANGLES, counts, GL_UNSIGNED_INT, offsets,
+                      drawCount);
   glBindVertexArray(0);
+
+  if (stats) {
+    stats->chunks++;
+    stats->drawCalls++;
+    for (GLsizei i = 0; i < drawCount; i++)
+      stats->indices += counts[i];
+  }
 }
@@ -1,29 +1,37 @@
 #pragma once
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <array>
 #include <cstdint>
 #include <vector>
 
+#include "../core/memory_stats.h"
+#include "../world/chunkMesh.h"
+
+class StagingRing;
+
 class Chunk {
  public:
   Chunk(unsigned int chunkWidth,
         unsigned int chunkHeight,
         const std::vector<unsigned int>& chunkData,
-        const glm::vec3& position);
+        const glm::vec3& position,
+        StagingRing* stagingRing = nullptr,
+        unsigned int scale = 1);
   ~Chunk();
 
-  void Render(const glm::mat4& modelMatrix);
-
-  void GenerateChunkTerrain();
+  // What Render issued, summed over every chunk of a pass.
+  struct DrawStats {
+    int chunks = 0;
+    int drawCalls = 0;
+    uint64_t indices = 0;
+  };
 
-  // Rebuilds mesh using neighbor chunk data for correct border face culling.
-  // Pass nullptr for neighbors that don't exist (treated as air).
-  void GenerateChunkMesh(
-      const std::vector<unsigned int>* negX = nullptr,
-      const std::vector<unsigned int>* posX = nullptr,
-      const std::vector<unsigned int>* negZ = nullptr,
-      const std::vector<unsigned int>* posZ = nullptr);
+  // Draws only the face buckets that can face the camera. Counts the draw
+  // into stats when one is passed.
+  void Render(const glm::vec3& cameraPos, DrawStats* stats = nullptr);
 
+  // Remeshes against the neighbors' data and uploads the result.
   void RebuildMesh(
       const std::vector<unsigned int>* negX,
       const std::vector<unsigned int>* posX,
@@ -31,23 +39,51 @@ class Chunk {
       const std::vector<unsigned int>* posZ);
 
   void SetupBuffers();
-  void AddFace(int x, int y, int z,
-               glm::vec3 normal,
-               unsigned int& indexOffset,
-               int atlasCol, int atlasRow);
 
-  const std::vector<unsigned int>& getData() const { return chunkData; }
+  // Keep each chunk's CPU mesh after upload instead of handing it back to
+  // the mesher's pool, for debugging or software rendering. Applies to
+  // meshes uploaded from then on.
+  static void SetRetainCpuMesh(bool retain) { retainCpuMesh = retain; }
+
+  const std::vector<unsigned int>& getData() const { return mesh.getData(); }
+
+  // world-space size; LOD chunks cover scale blocks per cell
+  glm::vec3 Extent() const {
+    return glm::vec3(mesh.Width(), mesh.Height(), mesh.Width()) *
+           static_cast<float>(scale);
+  }
+  glm::vec3 Center() const { return position + Extent() * 0.5f; }
+
+  // bytes this chunk holds, also counted in MemoryStats
+  size_t VoxelBytes() const { return mesh.VoxelBytes(); }
+  size_t CpuMeshBytes() const { return mesh.MeshBytes(); }
+  size_t GpuMeshBytes() const { return gpuMemory.bytes(); }
 
   glm::vec3 position;
 
+  // Each chunk's VBO starts with its integer world origin and cell scale, read
+  // by the vertex shader as a per-instance attribute. Vertex data follows.
+  static constexpr GLsizeiptr ORIGIN_HEADER_BYTES = 4 * sizeof(int32_t);
+
  private:
-  unsigned int chunkWidth;
-  unsigned int chunkHeight;
-  std::vector<std::vector<std::vector<uint8_t>>> blocks;
-  std::vector<unsigned int> chunkData;
+  static inline bool retainCpuMesh = false;
+
+  unsigned int scale;
+  ChunkMesh mesh;
   GLuint vao = 0, vbo = 0, ebo = 0;
   unsigned int numIndices = 0;
 
-  std::vector<float> vertices;
-  std::vector<unsigned int> indices;
+  // GPU buffers are only re-specified when a remesh outgrows them
+  GLsizeiptr vboCapacity = 0;
+  GLsizeiptr eboCapacity = 0;
+  MemoryTracker gpuMemory{MEMORY_GPU_MESH};
+  StagingRing* stagingRing = nullptr;
+
+  void UploadMesh();
+  void UploadBuffer(GLuint buffer,
+                    GLsizeiptr& capacity,
+                    const void* header,
+                    GLsizeiptr headerSize,
+                    const void* data,
+                    GLsizeiptr size);
 };
@@ -0,0 +1,139 @@
+#include "flythrough.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../core/memory_stats.h"
+
+bool Flythrough::Load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Failed to open flythrough: " << path << " :c\n";
+    return false;
+  }
+
+  keyframes.clear();
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos)
+      line.erase(comment);
+    if (line.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    std::istringstream fields(line);
+    Keyframe key;
+    if (!(fields >> key.time >> key.position.x >> key.position.y >>
+          key.position.z >> key.yaw >> key.pitch)) {
+      std::cerr << path << ":" << lineNumber
+                << ": expected time x y z yaw pitch :c\n";
+      return false;
+    }
+    if (!keyframes.empty() && key.time <= keyframes.back().time) {
+      std::cerr << path << ":" << lineNumber
+                << ": keyframe times must increase :c\n";
+      return false;
+    }
+    keyframes.push_back(key);
+  }
+
+  if (keyframes.size() < 2) {
+    std::cerr << "Flythrough needs at least two keyframes: " << path
+              << " :c\n";
+    return false;
+  }
+  return true;
+}
+
+float Flythrough::Duration() const {
+  return keyframes.empty() ? 0.0f : keyframes.back().time;
+}
+
+template <typename T>
+static T catmullRom(const T& p0, const T& p1, const T& p2, const T& p3,
+                    float t) {
+  const float t2 = t * t;
+  const float t3 = t2 * t;
+  return 0.5f * ((2.0f * p1) + (p2 - p0) * t +
+                 (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+                 (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+Flythrough::Keyframe Flythrough::Sample(float time) const {
+  if (keyframes.empty())
+    return {0.0f, glm::vec3(0.0f), 0.0f, 0.0f};
+  if (time <= keyframes.front().time)
+    return keyframes.front();
+  if (time >= keyframes.back().time)
+    return keyframes.back();
+
+  // segment [i, i + 1] holds time; the ends repeat for the outer controls
+  size_t i = 0;
+  while (keyframes[i + 1].time < time)
+    i++;
+  const Keyframe& k0 = keyframes[i > 0 ? i - 1 : i];
+  const Keyframe& k1 = keyframes[i];
+  const Keyframe& k2 = keyframes[i + 1];
+  const Keyframe& k3 = keyframes[std::min(i + 2, keyframes.size() - 1)];
+  const float t = (time - k1.time) / (k2.time - k1.time);
+
+  Keyframe sample;
+  sample.time = time;
+  sample.position =
+      catmullRom(k0.position, k1.position, k2.position, k3.position, t);
+  sample.yaw = catmullRom(k0.yaw, k1.yaw, k2.yaw, k3.yaw, t);
+  sample.pitch = catmullRom(k0.pitch, k1.pitch, k2.pitch, k3.pitch, t);
+  return sample;
+}
+
+// nearest-rank percentile of sorted values
+template <typename T>
+static T percentile(const std::vector<T>& sorted, float p) {
+  if (sorted.empty())
+    return T();
+  size_t rank = static_cast<size_t>(p / 100.0f * sorted.size());
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+static void printLatencies(std::ostream& out,
+                           const char* label,
+                           std::vector<int> latencies,
+                           float stepMs) {
+  std::sort(latencies.begin(), latencies.end());
+  out << label << ": " << latencies.size() << " loads";
+  if (!latencies.empty()) {
+    out << ", p50 " << percentile(latencies, 50.0f) << " / p95 "
+        << percentile(latencies, 95.0f) << " / max " << latencies.back()
+        << " frames (max " << latencies.back() * stepMs << " ms)";
+  }
+  out << "\n";
+}
+
+void FlythroughStats::Print(std::ostream& out,
+                            const std::vector<int>& chunkLoadLatencies,
+                            const std::vector<int>& lodLoadLatencies,
+                            float stepMs) const {
+  std::vector<float> sorted = frameTimes;
+  std::sort(sorted.begin(), sorted.end());
+
+  // a hitch is a frame that took more than twice the median
+  const float median = percentile(sorted, 50.0f);
+  size_t hitches = 0;
+  for (float ms : frameTimes)
+    hitches += ms > 2.0f * median;
+
+  out << "Flythrough: " << frameTimes.size() << " frames\n";
+  if (!sorted.empty()) {
+    out << "Frame time: p50 " << median << " / p95 "
+        << percentile(sorted, 95.0f) << " / p99 " << percentile(sorted, 99.0f)
+        << " / max " << sorted.back() << " ms\n";
+  }
+  out << "Hitches (> 2x p50): " << hitches << "\n";
+  printLatencies(out, "Chunk load latency", chunkLoadLatencies, stepMs);
+  printLatencies(out, "LOD load latency", lodLoadLatencies, stepMs);
+  out << "Memory:\n";
+  MemoryStats::print(out);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Recorded camera path for the flythrough benchmark. The file is plain text,
+// one keyframe per line:
+//
+//   # time(s)  x  y  z  yaw  pitch
+//   0          0  60 50 -90  -10
+//
+// Positions and angles are interpolated with a Catmull-Rom spline, so the
+// camera moves smoothly through every keyframe.
+class Flythrough {
+ public:
+  struct Keyframe {
+    float time;
+    glm::vec3 position;
+    float yaw;
+    float pitch;
+  };
+
+  bool Load(const std::string& path);
+
+  float Duration() const;
+  Keyframe Sample(float time) const;
+
+ private:
+  std::vector<Keyframe> keyframes;
+};
+
+// Frame times collected over one run, summarised when it ends together with
+// the memory totals, so a regression in either shows up in the same report.
+class FlythroughStats {
+ public:
+  void AddFrame(float frameMs) { frameTimes.push_back(frameMs); }
+
+  // Load latencies are in Update calls, one per simulated step of stepMs.
+  void Print(std::ostream& out,
+             const std::vector<int>& chunkLoadLatencies,
+             const std::vector<int>& lodLoadLatencies,
+             float stepMs) const;
+
+ private:
+  std::vector<float> frameTimes;
+};
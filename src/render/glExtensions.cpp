@@ -0,0 +1,75 @@
+#include "glExtensions.h"
+
+#include <cstring>
+#include <iostream>
+
+PFNGLBUFFERSTORAGEPROC GLExtensions::bufferStorage = nullptr;
+PFNGLGETPROGRAMBINARYPROC GLExtensions::getProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC GLExtensions::programBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC GLExtensions::programParameteri = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSPROC GLExtensions::maxShaderCompilerThreads =
+    nullptr;
+
+int GLExtensions::versionMajor = 0;
+int GLExtensions::versionMinor = 0;
+
+void GLExtensions::load(GLADloadproc loader) {
+  glGetIntegerv(GL_MAJOR_VERSION, &versionMajor);
+  glGetIntegerv(GL_MINOR_VERSION, &versionMinor);
+
+  if (hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage")) {
+    bufferStorage = (PFNGLBUFFERSTORAGEPROC)loader("glBufferStorage");
+  }
+
+  if (hasVersion(4, 1) || hasExtension("GL_ARB_get_program_binary")) {
+    // some drivers expose the entry points but no binary format
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats > 0) {
+      getProgramBinary =
+          (PFNGLGETPROGRAMBINARYPROC)loader("glGetProgramBinary");
+      programBinary = (PFNGLPROGRAMBINARYPROC)loader("glProgramBinary");
+      programParameteri =
+          (PFNGLPROGRAMPARAMETERIPROC)loader("glProgramParameteri");
+      if (!getProgramBinary || !programBinary || !programParameteri) {
+        getProgramBinary = nullptr;
+        programBinary = nullptr;
+        programParameteri = nullptr;
+      }
+    }
+  }
+
+  if (hasExtension("GL_KHR_parallel_shader_compile")) {
+    maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)loader(
+        "glMaxShaderCompilerThreadsKHR");
+  } else if (hasExtension("GL_ARB_parallel_shader_compile")) {
+    maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSPROC)loader(
+        "glMaxShaderCompilerThreadsARB");
+  }
+  // let the driver pick how many threads to use
+  if (maxShaderCompilerThreads)
+    maxShaderCompilerThreads(0xFFFFFFFFu);
+
+  std::cout << "GL " << versionMajor << "." << versionMinor
+            << " buffer storage: " << (bufferStorage ? "yes" : "no")
+            << ", program binaries: " << (programBinary ? "yes" : "no")
+            << ", parallel shader compile: "
+            << (maxShaderCompilerThreads ? "yes" : "no") << "\n";
+}
+
+bool GLExtensions::hasExtension(const char* name) {
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; i++) {
+    const char* ext =
+        reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+    if (ext && std::strcmp(ext, name) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool GLExtensions::hasVersion(int major, int minor) {
+  return versionMajor > major ||
+         (versionMajor == major && versionMinor >= minor);
+}
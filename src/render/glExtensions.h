@@ -0,0 +1,82 @@
+#ifndef GL_EXTENSIONS_H
+#define GL_EXTENSIONS_H
+
+#include <glad/glad.h>
+
+// glad is generated for plain GL 4.0 with no extensions, so anything newer is
+// declared here and loaded at runtime. Pointers stay null when unsupported.
+
+// GL 4.4 / ARB_buffer_storage
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#endif
+
+// GL 4.6 / ARB_pipeline_statistics_query
+#ifndef GL_FRAGMENT_SHADER_INVOCATIONS
+#define GL_FRAGMENT_SHADER_INVOCATIONS 0x82F4
+#endif
+
+// GL 4.6 / EXT_texture_filter_anisotropic
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+// GL 4.1 / ARB_get_program_binary
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+typedef void(APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target,
+                                                GLsizeiptr size,
+                                                const void* data,
+                                                GLbitfield flags);
+typedef void(APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program,
+                                                   GLsizei bufSize,
+                                                   GLsizei* length,
+                                                   GLenum* binaryFormat,
+                                                   void* binary);
+typedef void(APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program,
+                                                GLenum binaryFormat,
+                                                const void* binary,
+                                                GLsizei length);
+typedef void(APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program,
+                                                    GLenum pname,
+                                                    GLint value);
+typedef void(APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSPROC)(GLuint count);
+
+class GLExtensions {
+ public:
+  // call once after gladLoadGLLoader with the same loader
+  static void load(GLADloadproc loader);
+
+  static bool hasExtension(const char* name);
+  static bool hasVersion(int major, int minor);
+
+  static PFNGLBUFFERSTORAGEPROC bufferStorage;
+
+  // all null unless the driver can also hand out program binaries
+  static PFNGLGETPROGRAMBINARYPROC getProgramBinary;
+  static PFNGLPROGRAMBINARYPROC programBinary;
+  static PFNGLPROGRAMPARAMETERIPROC programParameteri;
+
+  // set when shader compiles may run on driver threads
+  static PFNGLMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreads;
+
+ private:
+  static int versionMajor;
+  static int versionMinor;
+};
+
+#endif
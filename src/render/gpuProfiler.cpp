@@ -0,0 +1,184 @@
+#include "gpuProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "overlay.h"
+
+GpuProfiler::GpuProfiler() {}
+
+GpuProfiler::~GpuProfiler() {
+  for (FrameQueries& queries : frames) {
+    if (!queries.queries.empty())
+      glDeleteQueries(queries.queries.size(), queries.queries.data());
+  }
+}
+
+int GpuProfiler::PassIndex(const char* name) {
+  for (size_t i = 0; i < passNames.size(); i++) {
+    if (passNames[i] == name)
+      return static_cast<int>(i);
+  }
+  passNames.push_back(name);
+  return static_cast<int>(passNames.size() - 1);
+}
+
+void GpuProfiler::BeginFrame() {
+  FrameQueries& queries = frames[frame % LATENCY];
+  // the oldest slot is about to be reused; collect it if it's ready
+  if (queries.issued)
+    Collect(queries);
+  queries.passes.clear();
+  queries.issued = false;
+}
+
+void GpuProfiler::EndFrame() {
+  if (inPass)
+    EndPass();
+  frames[frame % LATENCY].issued = true;
+  frame++;
+}
+
+void GpuProfiler::BeginPass(const char* name) {
+  if (inPass)
+    EndPass();
+
+  FrameQueries& queries = frames[frame % LATENCY];
+  const size_t needed = (queries.passes.size() + 1) * 2;
+  if (queries.queries.size() < needed) {
+    size_t old = queries.queries.size();
+    queries.queries.resize(needed);
+    glGenQueries(needed - old, queries.queries.data() + old);
+  }
+
+  queries.passes.push_back(PassIndex(name));
+  glQueryCounter(queries.queries[needed - 2], GL_TIMESTAMP);
+  inPass = true;
+}
+
+void GpuProfiler::EndPass() {
+  if (!inPass)
+    return;
+  FrameQueries& queries = frames[frame % LATENCY];
+  glQueryCounter(queries.queries[queries.passes.size() * 2 - 1], GL_TIMESTAMP);
+  inPass = false;
+}
+
+void GpuProfiler::Collect(FrameQueries& queries) {
+  if (queries.passes.empty())
+    return;
+
+  // the last timestamp finishes last; if it isn't there, skip the frame
+  // rather than stall
+  GLuint available = 0;
+  glGetQueryObjectuiv(queries.queries[queries.passes.size() * 2 - 1],
+                      GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return;
+
+  std::vector<float> times(passNames.size(), -1.0f);
+  for (size_t i = 0; i < queries.passes.size(); i++) {
+    GLuint64 start = 0, end = 0;
+    glGetQueryObjectui64v(queries.queries[i * 2], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(queries.queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+    float& time = times[queries.passes[i]];
+    time = std::max(time, 0.0f) + static_cast<float>(end - start) / 1.0e6f;
+  }
+
+  if (history.size() < WINDOW) {
+    history.push_back(std::move(times));
+    historyFrames.push_back(collectedFrames);
+  } else {
+    history[historyHead] = std::move(times);
+    historyFrames[historyHead] = collectedFrames;
+    historyHead = (historyHead + 1) % WINDOW;
+  }
+  collectedFrames++;
+}
+
+std::vector<GpuProfiler::PassStats> GpuProfiler::Stats() const {
+  std::vector<PassStats> stats;
+  std::vector<float> samples;
+  for (size_t pass = 0; pass < passNames.size(); pass++) {
+    samples.clear();
+    for (const std::vector<float>& times : history) {
+      if (pass < times.size() && times[pass] >= 0.0f)
+        samples.push_back(times[pass]);
+    }
+
+    PassStats entry = {passNames[pass], static_cast<int>(samples.size()), 0,
+                       0, 0};
+    if (!samples.empty()) {
+      std::sort(samples.begin(), samples.end());
+      float sum = 0.0f;
+      for (float sample : samples)
+        sum += sample;
+      size_t p99 = static_cast<size_t>(std::ceil(samples.size() * 0.99)) - 1;
+      entry.minMs = samples.front();
+      entry.avgMs = sum / samples.size();
+      entry.p99Ms = samples[p99];
+    }
+    stats.push_back(entry);
+  }
+  return stats;
+}
+
+bool GpuProfiler::WriteCsv(const std::string& path) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "couldnt write gpu profile " << path << " :c" << std::endl;
+    return false;
+  }
+
+  file << "frame";
+  for (const std::string& name : passNames)
+    file << "," << name << "_ms";
+  file << "\n";
+
+  for (size_t i = 0; i < history.size(); i++) {
+    size_t row = (historyHead + i) % history.size();
+    const std::vector<float>& times = history[row];
+    file << historyFrames[row];
+    for (size_t pass = 0; pass < passNames.size(); pass++) {
+      file << ",";
+      if (pass < times.size() && times[pass] >= 0.0f)
+        file << times[pass];
+    }
+    file << "\n";
+  }
+  return static_cast<bool>(file);
+}
+
+void GpuProfiler::AddToOverlay(Overlay& overlay,
+                               float x,
+                               float y,
+                               float width,
+                               float budgetMs) const {
+  // same order as Stats(), so the console legend matches
+  static const uint32_t COLORS[] = {0xFFF7C34F, 0xFF84C781, 0xFF4DB7FF,
+                                    0xFF7373E5, 0xFFC868BA, 0xFF76F1FF,
+                                    0xFFACB64D, 0xFF7F88A1};
+  const float rowHeight = 10.0f;
+  const float scale = width / budgetMs;
+
+  std::vector<PassStats> stats = Stats();
+  overlay.Rect(x - 4, y - 4, width + 8, stats.size() * (rowHeight + 4) + 4,
+               0x80000000);
+  for (size_t i = 0; i < stats.size(); i++) {
+    const PassStats& pass = stats[i];
+    const uint32_t color = COLORS[i % (sizeof(COLORS) / sizeof(COLORS[0]))];
+    const float rowY = y + i * (rowHeight + 4);
+    auto clampWidth = [&](float ms) { return std::min(ms * scale, width); };
+
+    // spread from fastest to p99, dimmed
+    overlay.Rect(x + clampWidth(pass.minMs), rowY,
+                 clampWidth(pass.p99Ms) - clampWidth(pass.minMs), rowHeight,
+                 (color & 0x00FFFFFF) | 0x60000000);
+    overlay.Rect(x, rowY + 2, clampWidth(pass.avgMs), rowHeight - 4, color);
+    overlay.Rect(x + clampWidth(pass.p99Ms) - 1, rowY, 2, rowHeight,
+                 0xFFFFFFFF);
+  }
+}
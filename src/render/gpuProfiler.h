@@ -0,0 +1,84 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+
+class Overlay;
+
+// Per-pass GPU timings from GL_TIMESTAMP queries. Every pass writes a
+// timestamp at its start and end; the queries are read back LATENCY frames
+// later so the CPU never waits on them. The last WINDOW frames are kept for
+// rolling min/avg/p99.
+//
+//   profiler.BeginFrame();
+//   profiler.BeginPass("terrain");
+//   ...draw...
+//   profiler.EndPass();
+//   profiler.EndFrame();
+//
+// Timestamps rather than GL_TIME_ELAPSED, so passes may sit inside other
+// timer queries.
+class GpuProfiler {
+ public:
+  static constexpr int LATENCY = 4;
+  static constexpr int WINDOW = 300;
+
+  struct PassStats {
+    std::string name;
+    int samples;
+    float minMs;
+    float avgMs;
+    float p99Ms;
+  };
+
+  GpuProfiler();
+  ~GpuProfiler();
+
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  void BeginFrame();
+  void EndFrame();
+
+  // passes don't nest; name should be a string literal
+  void BeginPass(const char* name);
+  void EndPass();
+
+  // one entry per pass seen so far, in first-seen order
+  std::vector<PassStats> Stats() const;
+
+  // one row per frame in the window, one column per pass (ms)
+  bool WriteCsv(const std::string& path) const;
+
+  // a bar per pass: min..p99 range with the average on top, scaled so
+  // budgetMs spans width pixels
+  void AddToOverlay(Overlay& overlay,
+                    float x,
+                    float y,
+                    float width,
+                    float budgetMs) const;
+
+ private:
+  struct FrameQueries {
+    std::vector<GLuint> queries;  // start/end pair per pass
+    std::vector<int> passes;
+    bool issued = false;
+  };
+
+  int PassIndex(const char* name);
+  void Collect(FrameQueries& frame);
+
+  FrameQueries frames[LATENCY];
+  int frame = 0;
+  bool inPass = false;
+
+  std::vector<std::string> passNames;
+
+  // ms per pass of finished frames, oldest first after historyHead; a
+  // negative value means the pass didn't run that frame
+  std::vector<std::vector<float>> history;
+  std::vector<long> historyFrames;
+  int historyHead = 0;
+  long collectedFrames = 0;
+};
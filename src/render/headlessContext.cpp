@@ -0,0 +1,140 @@
+#include "headlessContext.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "../core/png_writer.h"
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+// Prefers the surfaceless platform, which never touches X11 or Wayland, and
+// falls back to the default display for EGL implementations without it.
+static EGLDisplay openDisplay() {
+  const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+      EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                                              EGL_DEFAULT_DISPLAY, nullptr);
+      if (display != EGL_NO_DISPLAY)
+        return display;
+    }
+  }
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+HeadlessContext::HeadlessContext(int width, int height)
+    : width(width), height(height) {
+  EGLDisplay eglDisplay = openDisplay();
+  EGLint major = 0, minor = 0;
+  if (eglDisplay == EGL_NO_DISPLAY ||
+      !eglInitialize(eglDisplay, &major, &minor)) {
+    std::cout << "Failed to initialize EGL :c" << std::endl;
+    return;
+  }
+  display = eglDisplay;
+
+  const char* extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+  if (!extensions ||
+      !std::strstr(extensions, "EGL_KHR_surfaceless_context") ||
+      !std::strstr(extensions, "EGL_KHR_create_context")) {
+    std::cout << "EGL " << major << "." << minor
+              << " can't create surfaceless GL 3.3 contexts :c" << std::endl;
+    return;
+  }
+
+  if (!eglBindAPI(EGL_OPENGL_API)) {
+    std::cout << "EGL has no desktop OpenGL :c" << std::endl;
+    return;
+  }
+
+  // no surface, so any config will do (or none, with EGL_KHR_no_config_context)
+  EGLConfig config = nullptr;
+  EGLint configCount = 0;
+  const EGLint configAttribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                                  EGL_NONE};
+  eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configCount);
+
+  const EGLint contextAttribs[] = {
+      EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+      EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+      EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,
+      EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+      EGL_NONE};
+  EGLContext eglContext = eglCreateContext(
+      eglDisplay, configCount > 0 ? config : nullptr, EGL_NO_CONTEXT,
+      contextAttribs);
+  if (eglContext == EGL_NO_CONTEXT) {
+    std::cout << "Failed to create headless GL context :c" << std::endl;
+    return;
+  }
+  if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                      eglContext)) {
+    std::cout << "Failed to make headless GL context current :c"
+              << std::endl;
+    eglDestroyContext(eglDisplay, eglContext);
+    return;
+  }
+  context = eglContext;
+  std::cout << "Headless EGL " << major << "." << minor << " context, "
+            << width << "x" << height << "\n";
+}
+
+HeadlessContext::~HeadlessContext() {
+  if (framebuffer != 0) {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &colorBuffer);
+    glDeleteRenderbuffers(1, &depthBuffer);
+  }
+  if (context) {
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display, context);
+  }
+  if (display)
+    eglTerminate(display);
+}
+
+void* HeadlessContext::GetProcAddress(const char* name) {
+  return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+bool HeadlessContext::CreateFramebuffer() {
+  glGenRenderbuffers(1, &colorBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+  glGenRenderbuffers(1, &depthBuffer);
+  glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+  glGenFramebuffers(1, &framebuffer);
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                            GL_RENDERBUFFER, colorBuffer);
+  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                            GL_RENDERBUFFER, depthBuffer);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    std::cout << "Headless framebuffer is incomplete :c" << std::endl;
+    return false;
+  }
+
+  glViewport(0, 0, width, height);
+  return true;
+}
+
+bool HeadlessContext::SaveFrame(const std::string& path) {
+  pixels.resize(static_cast<size_t>(width) * height * 4);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+  // a window would ignore alpha, so the image does too
+  for (size_t i = 3; i < pixels.size(); i += 4)
+    pixels[i] = 255;
+  return writePng(path, width, height, pixels.data());
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+
+// GL 3.3 core context with no window and no display server: EGL on Mesa's
+// surfaceless platform, which also works on llvmpipe when there is no GPU.
+// Frames are drawn into an offscreen framebuffer that stays bound, so the
+// rest of the renderer doesn't know the difference.
+//
+//   HeadlessContext context(1920, 1080);   // context is current
+//   gladLoadGLLoader(HeadlessContext::GetProcAddress);
+//   context.CreateFramebuffer();
+class HeadlessContext {
+ public:
+  HeadlessContext(int width, int height);
+  ~HeadlessContext();
+
+  HeadlessContext(const HeadlessContext&) = delete;
+  HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+  bool IsValid() const { return context != nullptr; }
+
+  static void* GetProcAddress(const char* name);
+
+  // needs GL loaded; binds the framebuffer and sets the viewport
+  bool CreateFramebuffer();
+
+  // reads back the color buffer and writes it as a PNG
+  bool SaveFrame(const std::string& path);
+
+ private:
+  int width;
+  int height;
+  void* display = nullptr;
+  void* context = nullptr;
+  GLuint framebuffer = 0;
+  GLuint colorBuffer = 0;
+  GLuint depthBuffer = 0;
+  std::vector<unsigned char> pixels;
+};
@@ -0,0 +1,197 @@
+#include "horizon.h"
+
+#include "../core/trace.h"
+
+#include <cmath>
+#include <iostream>
+
+// Texture unit the height array is bound to. Unit 0 holds the block texture
+// array, so the height array is only ever bound on its own unit.
+static constexpr int HEIGHT_TEXTURE_UNIT = 1;
+
+static int wrap(int value) {
+  int m = value % Horizon::TEXTURE_SIZE;
+  return m < 0 ? m + Horizon::TEXTURE_SIZE : m;
+}
+
+std::vector<std::string> Horizon::ShaderDefines() {
+  return {"TEXTURE_SIZE=" + std::to_string(TEXTURE_SIZE)};
+}
+
+Horizon::Horizon(HeightFunction heightFunction, int baseSpacing)
+    : heightFunction(std::move(heightFunction)) {
+  for (int i = 0; i < LEVELS; i++)
+    levels[i].spacing = baseSpacing << i;
+
+  glGenTextures(1, &heightTexture);
+  glActiveTexture(GL_TEXTURE0 + HEIGHT_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, heightTexture);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32F, TEXTURE_SIZE, TEXTURE_SIZE,
+               LEVELS, 0, GL_RED, GL_FLOAT, nullptr);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
+  textureMemory.set(TEXTURE_SIZE * TEXTURE_SIZE * LEVELS * sizeof(float));
+
+  // one grid shared by every level; positions come from the height texture
+  std::vector<int16_t> vertices;
+  vertices.reserve(GRID_SIZE * GRID_SIZE * 2);
+  for (int z = 0; z < GRID_SIZE; z++) {
+    for (int x = 0; x < GRID_SIZE; x++) {
+      vertices.push_back(static_cast<int16_t>(x));
+      vertices.push_back(static_cast<int16_t>(z));
+    }
+  }
+
+  std::vector<unsigned int> indices;
+  indices.reserve((GRID_SIZE - 1) * (GRID_SIZE - 1) * 6);
+  for (int z = 0; z < GRID_SIZE - 1; z++) {
+    for (int x = 0; x < GRID_SIZE - 1; x++) {
+      unsigned int i = z * GRID_SIZE + x;
+      indices.insert(indices.end(), {i, i + GRID_SIZE, i + GRID_SIZE + 1,
+                                     i + GRID_SIZE + 1, i + 1, i});
+    }
+  }
+  numIndices = static_cast<GLsizei>(indices.size());
+
+  glGenVertexArrays(1, &vao);
+  glGenBuffers(1, &vbo);
+  glGenBuffers(1, &ebo);
+  glBindVertexArray(vao);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(int16_t),
+               vertices.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
+               indices.data(), GL_STATIC_DRAW);
+  glVertexAttribIPointer(0, 2, GL_SHORT, 0, (void*)0);
+  glEnableVertexAttribArray(0);
+  glBindVertexArray(0);
+  meshMemory.set(vertices.size() * sizeof(int16_t) +
+                 indices.size() * sizeof(unsigned int));
+
+  scratch.resize(TEXTURE_SIZE);
+}
+
+Horizon::~Horizon() {
+  glDeleteTextures(1, &heightTexture);
+  glDeleteVertexArrays(1, &vao);
+  glDeleteBuffers(1, &vbo);
+  glDeleteBuffers(1, &ebo);
+}
+
+float Horizon::Distance() const {
+  return static_cast<float>(levels[LEVELS - 1].spacing * (GRID_SIZE / 2));
+}
+
+void Horizon::Update(const glm::vec3& cameraPos) {
+  TRACE_ZONE("Horizon::Update");
+  glActiveTexture(GL_TEXTURE0 + HEIGHT_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, heightTexture);
+  for (int i = 0; i < LEVELS; i++) {
+    const float spacing = static_cast<float>(levels[i].spacing);
+    glm::ivec2 cell(static_cast<int>(std::floor(cameraPos.x / spacing)),
+                    static_cast<int>(std::floor(cameraPos.z / spacing)));
+    // snap to even cells so each level's vertices sit on the next one's
+    glm::ivec2 origin = ((cell - GRID_SIZE / 2) >> 1) << 1;
+    UpdateLevel(i, origin);
+  }
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+// Regenerates only the texels that scrolled in. The window covers
+// TEXTURE_SIZE consecutive cells per axis, so a new column at world cell x
+// owns the whole texture column wrap(x).
+void Horizon::UpdateLevel(int level, glm::ivec2 newOrigin) {
+  Level& l = levels[level];
+  glm::ivec2 delta = newOrigin - l.origin;
+  if (l.valid && delta == glm::ivec2(0))
+    return;
+
+  if (!l.valid || std::abs(delta.x) >= TEXTURE_SIZE ||
+      std::abs(delta.y) >= TEXTURE_SIZE) {
+    l.origin = newOrigin;
+    for (int x = 0; x < TEXTURE_SIZE; x++)
+      UploadColumn(level, newOrigin.x + x);
+    l.valid = true;
+    return;
+  }
+
+  // columns first, against the new x window and old z window...
+  l.origin.x = newOrigin.x;
+  if (delta.x > 0) {
+    for (int x = TEXTURE_SIZE - delta.x; x < TEXTURE_SIZE; x++)
+      UploadColumn(level, newOrigin.x + x);
+  } else {
+    for (int x = 0; x < -delta.x; x++)
+      UploadColumn(level, newOrigin.x + x);
+  }
+
+  // ...then rows against the new z window
+  l.origin.y = newOrigin.y;
+  if (delta.y > 0) {
+    for (int z = TEXTURE_SIZE - delta.y; z < TEXTURE_SIZE; z++)
+      UploadRow(level, newOrigin.y + z);
+  } else {
+    for (int z = 0; z < -delta.y; z++)
+      UploadRow(level, newOrigin.y + z);
+  }
+}
+
+void Horizon::UploadColumn(int level, int cellX) {
+  const Level& l = levels[level];
+  for (int z = 0; z < TEXTURE_SIZE; z++) {
+    int cellZ = l.origin.y + z;
+    scratch[wrap(cellZ)] = heightFunction(static_cast<float>(cellX * l.spacing),
+                                          static_cast<float>(cellZ * l.spacing));
+  }
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, wrap(cellX), 0, level, 1,
+                  TEXTURE_SIZE, 1, GL_RED, GL_FLOAT, scratch.data());
+}
+
+void Horizon::UploadRow(int level, int cellZ) {
+  const Level& l = levels[level];
+  for (int x = 0; x < TEXTURE_SIZE; x++) {
+    int cellX = l.origin.x + x;
+    scratch[wrap(cellX)] = heightFunction(static_cast<float>(cellX * l.spacing),
+                                          static_cast<float>(cellZ * l.spacing));
+  }
+  glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, wrap(cellZ), level, TEXTURE_SIZE,
+                  1, 1, GL_RED, GL_FLOAT, scratch.data());
+}
+
+void Horizon::Render(Shader& shader, const glm::ivec4& voxelBounds) {
+  shader.useShader();
+  shader.setInt("heights", HEIGHT_TEXTURE_UNIT);
+  shader.setInt("gridSize", GRID_SIZE);
+
+  glActiveTexture(GL_TEXTURE0 + HEIGHT_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, heightTexture);
+  glBindVertexArray(vao);
+
+  for (int i = 0; i < LEVELS; i++) {
+    const Level& l = levels[i];
+
+    // cut out whatever the next finer layer already draws
+    glm::ivec4 inner = voxelBounds;
+    if (i > 0) {
+      const Level& fine = levels[i - 1];
+      inner = glm::ivec4(fine.origin * fine.spacing,
+                         (fine.origin + GRID_SIZE - 1) * fine.spacing);
+    }
+
+    shader.setInt("level", i);
+    shader.setInt("spacing", l.spacing);
+    shader.setIVec2("origin", l.origin);
+    shader.setIVec4("innerBounds", inner);
+    glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, 0);
+  }
+
+  glBindVertexArray(0);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
+}
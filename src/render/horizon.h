@@ -0,0 +1,70 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../core/memory_stats.h"
+#include "shader.h"
+
+// Far terrain past the voxel LOD rings, drawn as a geometry clipmap: nested
+// grids of GRID_SIZE vertices whose spacing doubles per level, all sampled
+// from the same height function as the voxels. Heights live in a texture
+// array (one layer per level) that is addressed toroidally, so when the camera
+// moves only the rows and columns that scrolled into view are regenerated.
+class Horizon {
+ public:
+  using HeightFunction = std::function<float(float worldX, float worldZ)>;
+
+  static constexpr int LEVELS = 3;
+  static constexpr int TEXTURE_SIZE = 128;
+  // the vertex shader wraps cells into the texture with a mask
+  static_assert((TEXTURE_SIZE & (TEXTURE_SIZE - 1)) == 0,
+                "TEXTURE_SIZE must be a power of two");
+  // odd vertex count so every level edge lands on its coarser level's grid
+  static constexpr int GRID_SIZE = TEXTURE_SIZE - 1;
+
+  Horizon(HeightFunction heightFunction, int baseSpacing);
+
+  // defines to build the horizon shaders with, so they use the sizes above
+  static std::vector<std::string> ShaderDefines();
+  ~Horizon();
+
+  Horizon(const Horizon&) = delete;
+  Horizon& operator=(const Horizon&) = delete;
+
+  // scrolls the height texture with the camera
+  void Update(const glm::vec3& cameraPos);
+
+  // voxelBounds is the (minX, minZ, maxX, maxZ) square already covered by
+  // voxel terrain; the horizon is cut out there
+  void Render(Shader& shader, const glm::ivec4& voxelBounds);
+
+  // edge of the outermost level
+  float Distance() const;
+
+ private:
+  struct Level {
+    int spacing;          // blocks between vertices
+    glm::ivec2 origin;    // grid cell of vertex (0, 0), in units of spacing
+    bool valid = false;
+  };
+
+  void UpdateLevel(int level, glm::ivec2 newOrigin);
+  void UploadColumn(int level, int cellX);
+  void UploadRow(int level, int cellZ);
+
+  HeightFunction heightFunction;
+  Level levels[LEVELS];
+
+  GLuint heightTexture = 0;
+  GLuint vao = 0, vbo = 0, ebo = 0;
+  GLsizei numIndices = 0;
+
+  std::vector<float> scratch;
+
+  MemoryTracker textureMemory{MEMORY_TEXTURES};
+  MemoryTracker meshMemory{MEMORY_GPU_MESH};
+};
@@ -0,0 +1,61 @@
+#include "overdrawCounter.h"
+
+#include "glExtensions.h"
+
+static bool resultAvailable(GLuint query) {
+  GLuint available = 0;
+  glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  return available != 0;
+}
+
+OverdrawCounter::OverdrawCounter() {
+  invocationsSupported = GLExtensions::hasVersion(4, 6) ||
+                         GLExtensions::hasExtension(
+                             "GL_ARB_pipeline_statistics_query");
+
+  glGenQueries(LATENCY, samplesQueries);
+  if (invocationsSupported)
+    glGenQueries(LATENCY, invocationQueries);
+}
+
+OverdrawCounter::~OverdrawCounter() {
+  glDeleteQueries(LATENCY, samplesQueries);
+  if (invocationsSupported)
+    glDeleteQueries(LATENCY, invocationQueries);
+}
+
+void OverdrawCounter::Begin() {
+  int slot = frame % LATENCY;
+
+  // the oldest slot is about to be reused; collect it if both queries are
+  // ready, reading a result that isn't would stall until it is
+  if (issued[slot]) {
+    const bool available =
+        resultAvailable(samplesQueries[slot]) &&
+        (!invocationsSupported || resultAvailable(invocationQueries[slot]));
+    if (available) {
+      GLuint64 value = 0;
+      glGetQueryObjectui64v(samplesQueries[slot], GL_QUERY_RESULT, &value);
+      samplesPassed = value;
+      if (invocationsSupported) {
+        glGetQueryObjectui64v(invocationQueries[slot], GL_QUERY_RESULT,
+                              &value);
+        fragmentInvocations = value;
+      }
+      hasResults = true;
+    }
+  }
+
+  glBeginQuery(GL_SAMPLES_PASSED, samplesQueries[slot]);
+  if (invocationsSupported)
+    glBeginQuery(GL_FRAGMENT_SHADER_INVOCATIONS, invocationQueries[slot]);
+}
+
+void OverdrawCounter::End() {
+  int slot = frame % LATENCY;
+  glEndQuery(GL_SAMPLES_PASSED);
+  if (invocationsSupported)
+    glEndQuery(GL_FRAGMENT_SHADER_INVOCATIONS);
+  issued[slot] = true;
+  frame++;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstdint>
+
+// Debug counter for overdraw. Brackets a pass with a GL_SAMPLES_PASSED query
+// and, where ARB_pipeline_statistics_query is available, a fragment shader
+// invocation query. Results are read back a few frames late so the CPU never
+// waits on the GPU.
+class OverdrawCounter {
+ public:
+  OverdrawCounter();
+  ~OverdrawCounter();
+
+  OverdrawCounter(const OverdrawCounter&) = delete;
+  OverdrawCounter& operator=(const OverdrawCounter&) = delete;
+
+  void Begin();
+  void End();
+
+  bool HasResults() const { return hasResults; }
+  bool HasInvocations() const { return invocationsSupported; }
+
+  // results of the most recent finished frame
+  uint64_t SamplesPassed() const { return samplesPassed; }
+  uint64_t FragmentInvocations() const { return fragmentInvocations; }
+
+ private:
+  static constexpr int LATENCY = 3;
+
+  GLuint samplesQueries[LATENCY] = {};
+  GLuint invocationQueries[LATENCY] = {};
+  bool issued[LATENCY] = {};
+  bool invocationsSupported = false;
+  int frame = 0;
+
+  bool hasResults = false;
+  uint64_t samplesPassed = 0;
+  uint64_t fragmentInvocations = 0;
+};
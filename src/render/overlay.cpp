@@ -0,0 +1,224 @@
+#include "overlay.h"
+
+#include <cstddef>
+
+static constexpr int FONT_TEXTURE_UNIT = 2;
+
+// 5x7 glyphs for ' ' through '_', one byte per row from the top, bit 4 is the
+// leftmost column
+static constexpr char FIRST_GLYPH = ' ';
+static constexpr char LAST_GLYPH = '_';
+static constexpr uint8_t FONT[LAST_GLYPH - FIRST_GLYPH + 1][7] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // ' '
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // !
+    {0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00},  // "
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},  // #
+    {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},  // $
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // %
+    {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},  // &
+    {0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00},  // '
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // (
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // )
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},  // *
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // +
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},  // ,
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // -
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // .
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},  // ;
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // <
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},  // =
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // >
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // ?
+    {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E},  // @
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // A
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // D
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+    {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},  // [
+    {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // backslash
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},  // ]
+    {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},  // ^
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},  // _
+};
+
+// every glyph, then one solid cell for rects
+static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+static constexpr int CELL_W = static_cast<int>(Overlay::GLYPH_WIDTH);
+static constexpr int CELL_H = static_cast<int>(Overlay::GLYPH_HEIGHT);
+static constexpr int ATLAS_WIDTH = (GLYPH_COUNT + 1) * CELL_W;
+
+Overlay::Overlay() {
+  glGenVertexArrays(1, &vao);
+  glGenBuffers(1, &vbo);
+
+  glBindVertexArray(vao);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                        (void*)offsetof(Vertex, x));
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex),
+                        (void*)offsetof(Vertex, color));
+  glEnableVertexAttribArray(1);
+  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                        (void*)offsetof(Vertex, u));
+  glEnableVertexAttribArray(2);
+  glBindVertexArray(0);
+
+  // bake the font, top row of each glyph first
+  std::vector<uint8_t> atlas(ATLAS_WIDTH * CELL_H, 0);
+  for (int glyph = 0; glyph < GLYPH_COUNT; glyph++) {
+    for (int row = 0; row < 7; row++) {
+      for (int col = 0; col < 5; col++) {
+        if (FONT[glyph][row] & (0x10 >> col))
+          atlas[row * ATLAS_WIDTH + glyph * CELL_W + col] = 255;
+      }
+    }
+  }
+  for (int row = 0; row < CELL_H; row++) {
+    for (int col = 0; col < CELL_W; col++)
+      atlas[row * ATLAS_WIDTH + GLYPH_COUNT * CELL_W + col] = 255;
+  }
+
+  glActiveTexture(GL_TEXTURE0 + FONT_TEXTURE_UNIT);
+  glGenTextures(1, &glyphTexture);
+  glBindTexture(GL_TEXTURE_2D, glyphTexture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, CELL_H, 0, GL_RED,
+               GL_UNSIGNED_BYTE, atlas.data());
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glyphMemory.set(atlas.size());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+Overlay::~Overlay() {
+  glDeleteVertexArrays(1, &vao);
+  glDeleteBuffers(1, &vbo);
+  glDeleteTextures(1, &glyphTexture);
+}
+
+void Overlay::Quad(float x,
+                   float y,
+                   float width,
+                   float height,
+                   float u0,
+                   float u1,
+                   uint32_t color) {
+  const Vertex corners[4] = {{x, y, u0, 0.0f, color},
+                             {x + width, y, u1, 0.0f, color},
+                             {x + width, y + height, u1, 1.0f, color},
+                             {x, y + height, u0, 1.0f, color}};
+  vertices.insert(vertices.end(), {corners[0], corners[1], corners[2],
+                                   corners[2], corners[3], corners[0]});
+}
+
+void Overlay::Rect(float x,
+                   float y,
+                   float width,
+                   float height,
+                   uint32_t color) {
+  if (width <= 0.0f || height <= 0.0f)
+    return;
+  // the middle of the solid cell, so filtering never reaches a glyph
+  const float u = (GLYPH_COUNT * CELL_W + CELL_W * 0.5f) / ATLAS_WIDTH;
+  Quad(x, y, width, height, u, u, color);
+}
+
+void Overlay::Text(float x,
+                   float y,
+                   std::string_view text,
+                   uint32_t color,
+                   float scale) {
+  const float cellW = GLYPH_WIDTH * scale;
+  const float cellH = GLYPH_HEIGHT * scale;
+  float penX = x;
+  for (char c : text) {
+    if (c == '\n') {
+      penX = x;
+      y += cellH;
+      continue;
+    }
+    if (c >= 'a' && c <= 'z')
+      c -= 'a' - 'A';
+    if (c < FIRST_GLYPH || c > LAST_GLYPH)
+      c = '?';
+    if (c != ' ') {
+      const float u0 = static_cast<float>((c - FIRST_GLYPH) * CELL_W);
+      Quad(penX, y, cellW, cellH, u0 / ATLAS_WIDTH,
+           (u0 + CELL_W) / ATLAS_WIDTH, color);
+    }
+    penX += cellW;
+  }
+}
+
+void Overlay::Draw(Shader& shader, int screenWidth, int screenHeight) {
+  if (vertices.empty())
+    return;
+
+  // small and rewritten every frame, so just orphan
+  const GLsizeiptr size = vertices.size() * sizeof(Vertex);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  if (size > vboCapacity)
+    vboCapacity = size * 2;
+  glBufferData(GL_ARRAY_BUFFER, vboCapacity, nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, size, vertices.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  shader.useShader();
+  shader.setVec2("screenSize", static_cast<float>(screenWidth),
+                 static_cast<float>(screenHeight));
+  shader.setInt("glyphs", FONT_TEXTURE_UNIT);
+  glActiveTexture(GL_TEXTURE0 + FONT_TEXTURE_UNIT);
+  glBindTexture(GL_TEXTURE_2D, glyphTexture);
+
+  glDisable(GL_DEPTH_TEST);
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  glBindVertexArray(vao);
+  glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices.size()));
+  glBindVertexArray(0);
+
+  glDisable(GL_BLEND);
+  glEnable(GL_DEPTH_TEST);
+  glActiveTexture(GL_TEXTURE0);
+
+  vertices.clear();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "../core/memory_stats.h"
+#include "shader.h"
+
+// Flat 2D shapes and text drawn on top of the frame, for debug displays.
+// Shapes are queued in pixels from the top left corner and drawn in one batch.
+// Colors are packed 0xAABBGGRR, the same byte order as block tints.
+//
+// Text uses a built-in 5x7 font baked into a one-row glyph atlas at startup.
+// The atlas also holds a solid cell that rects sample, so rects and text share
+// a shader and a draw call.
+class Overlay {
+ public:
+  // glyph cell in pixels at scale 1, including the spacing column and row
+  static constexpr float GLYPH_WIDTH = 6.0f;
+  static constexpr float GLYPH_HEIGHT = 8.0f;
+
+  Overlay();
+  ~Overlay();
+
+  Overlay(const Overlay&) = delete;
+  Overlay& operator=(const Overlay&) = delete;
+
+  void Rect(float x, float y, float width, float height, uint32_t color);
+
+  // x, y is the top left of the first glyph. '\n' starts a new line, lower
+  // case prints as upper case and anything else without a glyph as '?'.
+  void Text(float x,
+            float y,
+            std::string_view text,
+            uint32_t color,
+            float scale = 1.0f);
+
+  // draws and clears everything queued this frame
+  void Draw(Shader& shader, int screenWidth, int screenHeight);
+
+ private:
+  struct Vertex {
+    float x, y;
+    float u, v;
+    uint32_t color;
+  };
+
+  void Quad(float x,
+            float y,
+            float width,
+            float height,
+            float u0,
+            float u1,
+            uint32_t color);
+
+  std::vector<Vertex> vertices;
+  GLuint vao = 0, vbo = 0;
+  GLsizeiptr vboCapacity = 0;
+  GLuint glyphTexture = 0;
+  MemoryTracker glyphMemory{MEMORY_TEXTURES};
+};
@@ -0,0 +1,123 @@
+#include "perfHud.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+#include "../core/memory_stats.h"
+#include "overlay.h"
+
+static constexpr float TEXT_SCALE = 2.0f;
+static constexpr int LINE_CHARS = 40;
+static constexpr float GRAPH_HEIGHT = 80.0f;
+static constexpr float GRAPH_MS = 50.0f;  // top of the graph
+static constexpr float BUDGET_MS = 1000.0f / 60.0f;
+
+static std::string formatBytes(size_t bytes) {
+  char text[32];
+  if (bytes >= 1024 * 1024)
+    std::snprintf(text, sizeof(text), "%.1f MB", bytes / (1024.0 * 1024.0));
+  else if (bytes >= 1024)
+    std::snprintf(text, sizeof(text), "%.1f KB", bytes / 1024.0);
+  else
+    std::snprintf(text, sizeof(text), "%zu B", bytes);
+  return text;
+}
+
+void PerfHud::AddFrame(float frameMs) {
+  if (frameTimes.size() < HISTORY) {
+    frameTimes.push_back(frameMs);
+    return;
+  }
+  frameTimes[head] = frameMs;
+  head = (head + 1) % HISTORY;
+}
+
+void PerfHud::Reset() {
+  frameTimes.clear();
+  head = 0;
+}
+
+void PerfHud::AddToOverlay(Overlay& overlay,
+                           float right,
+                           float top,
+                           const Counters& counters) const {
+  const float lineHeight = Overlay::GLYPH_HEIGHT * TEXT_SCALE;
+  const float width = LINE_CHARS * Overlay::GLYPH_WIDTH * TEXT_SCALE;
+  const float x = right - width;
+
+  std::vector<std::string> lines;
+  char line[LINE_CHARS * 2];
+  auto add = [&lines, &line](int length) {
+    lines.emplace_back(line, std::min(length, LINE_CHARS));
+  };
+
+  float sum = 0.0f, worst = 0.0f;
+  for (float ms : frameTimes) {
+    sum += ms;
+    worst = std::max(worst, ms);
+  }
+  const float last = frameTimes.empty()
+                         ? 0.0f
+                         : frameTimes[(head + frameTimes.size() - 1) %
+                                      frameTimes.size()];
+  const float average = frameTimes.empty() ? 0.0f : sum / frameTimes.size();
+  add(std::snprintf(line, sizeof(line), "FRAME %.1f MS  AVG %.1f  MAX %.1f",
+                    last, average, worst));
+  if (counters.gpuFrameMs >= 0.0f)
+    add(std::snprintf(line, sizeof(line), "CPU %.2f MS  GPU %.2f MS",
+                      counters.cpuFrameMs, counters.gpuFrameMs));
+  else
+    add(std::snprintf(line, sizeof(line), "CPU %.2f MS  GPU N/A",
+                      counters.cpuFrameMs));
+  add(std::snprintf(line, sizeof(line), "RENDER DISTANCE %d",
+                    counters.renderDistance));
+
+  const World::Stats& world = counters.world;
+  add(std::snprintf(line, sizeof(line), "CHUNKS %d LOADED, %d PENDING",
+                    world.chunksLoaded, world.chunksPending));
+  add(std::snprintf(line, sizeof(line), "LOD %d LOADED, %d PENDING",
+                    world.lodLoaded, world.lodPending));
+  // streaming runs on the main thread, the pending counts are its queues
+  add(std::snprintf(line, sizeof(line), "WORKERS NONE, LOADS ON MAIN"));
+
+  const Chunk::DrawStats& draws = counters.draws;
+  const unsigned long long faces = draws.indices / 6;
+  add(std::snprintf(line, sizeof(line), "DRAWN %d CHUNKS, %d CALLS",
+                    draws.chunks, draws.drawCalls));
+  add(std::snprintf(line, sizeof(line), "FACES %llu  VERTS %llu", faces,
+                    faces * 4));
+  add(std::snprintf(line, sizeof(line), "UPLOADED %s",
+                    formatBytes(world.uploadedBytes).c_str()));
+  for (int i = 0; i < MEMORY_CATEGORY_COUNT; i++) {
+    const MemoryCategory category = static_cast<MemoryCategory>(i);
+    add(std::snprintf(line, sizeof(line), "%s %-12s %s",
+                      MemoryStats::isGpu(category) ? "GPU" : "CPU",
+                      MemoryStats::name(category),
+                      formatBytes(MemoryStats::current(category)).c_str()));
+  }
+
+  const float graphTop = top + lines.size() * lineHeight + 8.0f;
+  overlay.Rect(x - 4, top - 4, width + 8,
+               graphTop - top + GRAPH_HEIGHT + 8, 0x80000000);
+  for (size_t i = 0; i < lines.size(); i++)
+    overlay.Text(x, top + i * lineHeight, lines[i], 0xFFFFFFFF, TEXT_SCALE);
+
+  // one bar per frame, oldest on the left, with the 60 and 30 fps lines
+  const float barWidth = width / HISTORY;
+  const float graphBottom = graphTop + GRAPH_HEIGHT;
+  const size_t start = frameTimes.size() < HISTORY ? 0 : head;
+  for (size_t i = 0; i < frameTimes.size(); i++) {
+    const float ms = frameTimes[(start + i) % frameTimes.size()];
+    const float barHeight = std::min(ms / GRAPH_MS, 1.0f) * GRAPH_HEIGHT;
+    const uint32_t color = ms <= BUDGET_MS       ? 0xFF60D060
+                           : ms <= BUDGET_MS * 2 ? 0xFF40C0F0
+                                                 : 0xFF5050F0;
+    overlay.Rect(x + i * barWidth, graphBottom - barHeight, barWidth,
+                 barHeight, color);
+  }
+  for (float ms : {BUDGET_MS, BUDGET_MS * 2}) {
+    overlay.Rect(x, graphBottom - ms / GRAPH_MS * GRAPH_HEIGHT, width, 1,
+                 0xA0FFFFFF);
+  }
+}
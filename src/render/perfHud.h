@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include "chunk.h"
+#include "world.h"
+
+class Overlay;
+
+// Text HUD with a frame time graph and the engine counters, drawn through the
+// Overlay. It only sees what it is handed, so while it is hidden main skips
+// feeding it and nothing is collected at all.
+class PerfHud {
+ public:
+  static constexpr int HISTORY = 240;
+
+  struct Counters {
+    float cpuFrameMs;
+    float gpuFrameMs;  // negative until the first GPU timing comes back
+    int renderDistance;
+    Chunk::DrawStats draws;
+    World::Stats world;
+  };
+
+  // time from the start of the previous frame to the start of this one
+  void AddFrame(float frameMs);
+  // drops the graph, e.g. when the HUD comes back after being hidden
+  void Reset();
+
+  // anchored at its top right corner
+  void AddToOverlay(Overlay& overlay,
+                    float right,
+                    float top,
+                    const Counters& counters) const;
+
+ private:
+  std::vector<float> frameTimes;  // ring, oldest at head once full
+  size_t head = 0;
+};
@@ -0,0 +1,92 @@
+#include "renderDistanceController.h"
+
+#include <algorithm>
+#include <iostream>
+
+RenderDistanceController::RenderDistanceController(int initialDistance,
+                                                   int minDistance,
+                                                   int maxDistance,
+                                                   float targetFrameMs)
+    : distance(initialDistance),
+      minDistance(minDistance),
+      maxDistance(std::max(minDistance, maxDistance)),
+      targetMs(targetFrameMs) {
+  distance = std::clamp(distance, this->minDistance, this->maxDistance);
+  ceiling = this->maxDistance + 1;
+  glGenQueries(LATENCY, startQueries);
+  glGenQueries(LATENCY, endQueries);
+}
+
+RenderDistanceController::~RenderDistanceController() {
+  glDeleteQueries(LATENCY, startQueries);
+  glDeleteQueries(LATENCY, endQueries);
+}
+
+void RenderDistanceController::CollectGpuTime(int slot) {
+  if (!issued[slot])
+    return;
+  GLuint available = 0;
+  glGetQueryObjectuiv(endQueries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return;
+
+  GLuint64 start = 0, end = 0;
+  glGetQueryObjectui64v(startQueries[slot], GL_QUERY_RESULT, &start);
+  glGetQueryObjectui64v(endQueries[slot], GL_QUERY_RESULT, &end);
+  float ms = static_cast<float>(end - start) / 1.0e6f;
+  gpuMs = hasGpuTime ? gpuMs + (ms - gpuMs) * SMOOTHING : ms;
+  hasGpuTime = true;
+}
+
+void RenderDistanceController::BeginFrame() {
+  int slot = frame % LATENCY;
+  // the oldest slot is about to be reused; collect it if it's ready
+  CollectGpuTime(slot);
+  glQueryCounter(startQueries[slot], GL_TIMESTAMP);
+}
+
+void RenderDistanceController::EndFrame(float cpuFrameMs) {
+  int slot = frame % LATENCY;
+  glQueryCounter(endQueries[slot], GL_TIMESTAMP);
+  issued[slot] = true;
+  frame++;
+
+  cpuMs = hasCpuTime ? cpuMs + (cpuFrameMs - cpuMs) * SMOOTHING : cpuFrameMs;
+  hasCpuTime = true;
+
+  Adjust();
+}
+
+void RenderDistanceController::Adjust() {
+  if (ceilingFrames > 0 && --ceilingFrames == 0)
+    ceiling = maxDistance + 1;
+
+  // loading and unloading after a change skews the numbers for a bit
+  if (cooldown > 0) {
+    cooldown--;
+    return;
+  }
+
+  float frameMs = std::max(cpuMs, hasGpuTime ? gpuMs : 0.0f);
+  overBudgetFrames = frameMs > targetMs * SHRINK_ABOVE ? overBudgetFrames + 1 : 0;
+  underBudgetFrames = frameMs < targetMs * GROW_BELOW ? underBudgetFrames + 1 : 0;
+
+  int next = distance;
+  if (overBudgetFrames >= SHRINK_FRAMES && distance > minDistance) {
+    next = distance - 1;
+    ceiling = distance;
+    ceilingFrames = CEILING_FRAMES;
+  } else if (underBudgetFrames >= GROW_FRAMES && distance < maxDistance &&
+             distance + 1 < ceiling) {
+    next = distance + 1;
+  }
+  if (next == distance)
+    return;
+
+  std::cout << "Render distance " << distance << " -> " << next << " (cpu "
+            << cpuMs << " ms, gpu " << gpuMs << " ms)\n";
+  distance = next;
+  overBudgetFrames = 0;
+  underBudgetFrames = 0;
+  cooldown = COOLDOWN_FRAMES;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <glad/glad.h>
+
+// Picks the full-detail render distance from the frame time. CPU time is
+// handed in by the caller, GPU time comes from a pair of GL_TIMESTAMP queries
+// around the frame that are read back a few frames late, so measuring never
+// stalls. The slower of the two drives the decision:
+//  - over budget for a while: shrink by one chunk
+//  - well under budget for longer: grow by one chunk
+// After a change it waits for the streaming to settle, and a distance that
+// turned out too slow is not retried for a while, so it doesn't bounce
+// between two values.
+class RenderDistanceController {
+ public:
+  RenderDistanceController(int initialDistance,
+                           int minDistance,
+                           int maxDistance,
+                           float targetFrameMs = 1000.0f / 60.0f);
+  ~RenderDistanceController();
+
+  RenderDistanceController(const RenderDistanceController&) = delete;
+  RenderDistanceController& operator=(const RenderDistanceController&) =
+      delete;
+
+  void BeginFrame();
+  // cpuFrameMs is the time the CPU spent on the frame, without the swap
+  void EndFrame(float cpuFrameMs);
+
+  int Distance() const { return distance; }
+
+  // smoothed frame times
+  float CpuFrameMs() const { return cpuMs; }
+  float GpuFrameMs() const { return gpuMs; }
+  bool HasGpuTime() const { return hasGpuTime; }
+
+ private:
+  void CollectGpuTime(int slot);
+  void Adjust();
+
+  static constexpr int LATENCY = 4;
+  static constexpr float SMOOTHING = 0.1f;
+  static constexpr float SHRINK_ABOVE = 1.0f;   // of the target
+  static constexpr float GROW_BELOW = 0.7f;     // of the target
+  static constexpr int SHRINK_FRAMES = 20;
+  static constexpr int GROW_FRAMES = 120;
+  static constexpr int COOLDOWN_FRAMES = 90;
+  static constexpr int CEILING_FRAMES = 600;
+
+  GLuint startQueries[LATENCY] = {};
+  GLuint endQueries[LATENCY] = {};
+  bool issued[LATENCY] = {};
+  int frame = 0;
+
+  int distance;
+  int minDistance;
+  int maxDistance;
+  float targetMs;
+
+  float cpuMs = 0.0f;
+  float gpuMs = 0.0f;
+  bool hasCpuTime = false;
+  bool hasGpuTime = false;
+
+  int overBudgetFrames = 0;
+  int underBudgetFrames = 0;
+  int cooldown = COOLDOWN_FRAMES;
+  int ceiling;            // smallest distance known to be too slow
+  int ceilingFrames = 0;  // until the ceiling is forgotten
+};
@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "../core/path_manager.h"
+#include "glExtensions.h"
+#include "shader.h"
+
+// FNV-1a 64, for program cache keys
+static uint64_t hashBytes(std::string_view bytes,
+                          uint64_t hash = 14695981039346656037ull) {
+  for (char c : bytes) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static std::string glString(GLenum name) {
+  const GLubyte* value = glGetString(name);
+  return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+// header of a cached program binary, followed by the binary itself
+struct ProgramCacheHeader {
+  uint32_t magic;
+  uint32_t binaryFormat;
+  uint64_t key;
+  uint32_t length;
+  float compileMs;  // what building from source cost, to report the saving
+};
+static constexpr uint32_t PROGRAM_CACHE_MAGIC = 0x50485343;  // "CSHP"
+
+Shader::Shader(const char* vertexSource,
+               const char* fragmentSource,
+               const std::vector<std::string>& defines,
+               Build build) {
+  // GET SOURCE CODE FROM FILE
+  std::string vertexCode = injectDefines(readFile(vertexSource), defines);
+  std::string fragmentCode = injectDefines(readFile(fragmentSource), defines);
+  name = std::filesystem::path(vertexSource).filename().string() + " + " +
+         std::filesystem::path(fragmentSource).filename().string();
+  for (size_t i = 0; i < defines.size(); i++)
+    name += (i == 0 ? " [" : ", ") + defines[i];
+  if (!defines.empty())
+    name += "]";
+
+  // Cached binaries are only valid for the exact sources and driver that
+  // produced them, so both go into the key.
+  cacheKey = hashBytes(vertexCode);
+  cacheKey = hashBytes(fragmentCode, cacheKey);
+  cacheKey = hashBytes(glString(GL_RENDERER), cacheKey);
+  cacheKey = hashBytes(glString(GL_VERSION), cacheKey);
+  char keyName[32];
+  std::snprintf(keyName, sizeof(keyName), "%016llx.bin",
+                static_cast<unsigned long long>(cacheKey));
+  if (GLExtensions::programBinary)
+    cacheFile = PathManager::getCachePath(std::string("shaders/") + keyName);
+
+  buildStart = std::chrono::high_resolution_clock::now();
+  float compileMs = 0.0f;
+  if (!cacheFile.empty() && loadProgramBinary(cacheFile, cacheKey, compileMs)) {
+    auto end = std::chrono::high_resolution_clock::now();
+    float loadMs =
+        std::chrono::duration<float, std::milli>(end - buildStart).count();
+    std::cout << "Shader " << name << " loaded from cache in " << loadMs
+              << " ms, saved " << compileMs - loadMs << " ms\n";
+    built = true;
+    reflectUniforms();
+    return;
+  }
+
+  startCompile(vertexCode.c_str(), fragmentCode.c_str());
+  if (build == Build::Wait)
+    finishBuild();
+}
+
+std::string Shader::readFile(const char* path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "error reading shader file " << path << " :c" << std::endl;
+    return "";
+  }
+  // put all file content into a string
+  std::stringstream stream;
+  stream << file.rdbuf();
+  return stream.str();
+}
+
+// Puts "#define NAME 1" (or NAME VALUE) lines right after #version, which has to stay first.
+// The #line keeps compiler messages pointing at lines of the original file.
+std::string Shader::injectDefines(const std::string& code,
+                                  const std::vector<std::string>& defines) {
+  if (defines.empty())
+    return code;
+
+  size_t versionEnd = 0;
+  int versionLine = 0;
+  size_t version = code.find("#version");
+  if (version != std::string::npos) {
+    versionEnd = code.find('\n', version);
+    versionEnd = versionEnd == std::string::npos ? code.size() : versionEnd + 1;
+    versionLine = 1 + static_cast<int>(std::count(
+                          code.begin(), code.begin() + version, '\n'));
+  }
+
+  std::string injected = code.substr(0, versionEnd);
+  if (versionEnd > 0 && injected.back() != '\n')
+    injected += '\n';
+  for (const std::string& define : defines) {
+    const size_t equals = define.find('=');
+    if (equals == std::string::npos)
+      injected += "#define " + define + " 1\n";
+    else
+      injected += "#define " + define.substr(0, equals) + " " +
+                  define.substr(equals + 1) + "\n";
+  }
+  injected += "#line " + std::to_string(versionLine + 1) + "\n";
+  injected += code.substr(versionEnd);
+  return injected;
+}
+
+// Only queues the work; nothing here asks the driver for a result, so with
+// parallel shader compile the driver keeps going on its own threads.
+void Shader::startCompile(const char* cVertexCode, const char* cFragmentCode) {
+  // COMPILE SHADERS
+  vertexStage = glCreateShader(GL_VERTEX_SHADER);
+  glShaderSource(vertexStage, 1, &cVertexCode, NULL);
+  glCompileShader(vertexStage);
+
+  fragmentStage = glCreateShader(GL_FRAGMENT_SHADER);
+  glShaderSource(fragmentStage, 1, &cFragmentCode, NULL);
+  glCompileShader(fragmentStage);
+
+  // create shader program
+  shaderID = glCreateProgram();
+  glAttachShader(shaderID, vertexStage);
+  glAttachShader(shaderID, fragmentStage);
+  if (GLExtensions::programParameteri) {
+    GLExtensions::programParameteri(shaderID,
+                                    GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glLinkProgram(shaderID);
+}
+
+void Shader::finishBuild() {
+  if (built)
+    return;
+  built = true;
+
+  int success;
+  char infoLog[512];
+
+  glGetShaderiv(vertexStage, GL_COMPILE_STATUS, &success);
+  if (!success) {
+    glGetShaderInfoLog(vertexStage, 512, NULL, infoLog);
+    std::cerr << "Error compiling vertex shader " << name << " :c" << std::endl
+              << infoLog << std::endl;
+  }
+
+  glGetShaderiv(fragmentStage, GL_COMPILE_STATUS, &success);
+  if (!success) {
+    glGetShaderInfoLog(fragmentStage, 512, NULL, infoLog);
+    std::cerr << "Error compiling fragment shader " << name << " :c"
+              << std::endl
+              << infoLog << std::endl;
+  }
+
+  glGetProgramiv(shaderID, GL_LINK_STATUS, &success);
+  if (!success) {
+    glGetProgramInfoLog(shaderID, 512, NULL, infoLog);
+    std::cerr << "Error with linking program " << name << " :c" << std::endl
+              << infoLog << std::endl;
+  }
+
+  // clean up :)
+  glDetachShader(shaderID, vertexStage);
+  glDetachShader(shaderID, fragmentStage);
+  glDeleteShader(vertexStage);
+  glDeleteShader(fragmentStage);
+  vertexStage = fragmentStage = 0;
+
+  // for programs built side by side this overlaps with the others
+  auto end = std::chrono::high_resolution_clock::now();
+  float compileMs =
+      std::chrono::duration<float, std::milli>(end - buildStart).count();
+  std::cout << "Shader " << name << " compiled in " << compileMs << " ms\n";
+  if (success && !cacheFile.empty())
+    saveProgramBinary(cacheFile, cacheKey, compileMs);
+
+  reflectUniforms();
+}
+
+// Returns false when there's no usable binary, e.g. the driver rejects it
+// after an update; the caller then builds from source and overwrites it.
+bool Shader::loadProgramBinary(const std::string& path,
+                               uint64_t key,
+                               float& compileMs) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file)
+    return false;
+
+  ProgramCacheHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.magic != PROGRAM_CACHE_MAGIC || header.key != key)
+    return false;
+  std::vector<char> binary(header.length);
+  if (!file.read(binary.data(), binary.size()))
+    return false;
+
+  shaderID = glCreateProgram();
+  GLExtensions::programBinary(shaderID, header.binaryFormat, binary.data(),
+                              static_cast<GLsizei>(binary.size()));
+  GLint success = 0;
+  glGetProgramiv(shaderID, GL_LINK_STATUS, &success);
+  if (!success) {
+    std::cout << "cached shader " << path << " rejected, recompiling\n";
+    glDeleteProgram(shaderID);
+    shaderID = 0;
+    return false;
+  }
+
+  compileMs = header.compileMs;
+  return true;
+}
+
+void Shader::saveProgramBinary(const std::string& path,
+                               uint64_t key,
+                               float compileMs) {
+  GLint length = 0;
+  glGetProgramiv(shaderID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return;
+
+  ProgramCacheHeader header = {};
+  header.magic = PROGRAM_CACHE_MAGIC;
+  header.key = key;
+  header.compileMs = compileMs;
+  std::vector<char> binary(length);
+  GLsizei written = 0;
+  GLExtensions::getProgramBinary(shaderID, length, &written,
+                                 &header.binaryFormat, binary.data());
+  header.length = static_cast<uint32_t>(written);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(binary.data(), written);
+  if (!file)
+    std::cerr << "couldnt write shader cache " << path << " :c" << std::endl;
+}
+
+void Shader::reflectUniforms() {
+  uniformLocations.clear();
+
+  GLint count = 0, maxLength = 0;
+  glGetProgramiv(shaderID, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(shaderID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+  std::string name(maxLength, '\0');
+  for (GLint i = 0; i < count; i++) {
+    GLsizei length = 0;
+    GLint size = 0;
+    GLenum type = 0;
+    glGetActiveUniform(shaderID, i, maxLength, &length, &size, &type,
+                       name.data());
+    std::string_view uniform(name.data(), length);
+
+    // uniform block members have no location
+    GLint location = glGetUniformLocation(shaderID, name.c_str());
+    if (location < 0)
+      continue;
+
+    // arrays are reported as "name[0]", make plain "name" work too
+    if (uniform.ends_with("[0]"))
+      uniform.remove_suffix(3);
+
+    auto [it, inserted] =
+        uniformLocations.emplace(hashUniformName(uniform), location);
+    if (!inserted) {
+      std::cerr << "uniform name hash collision on " << uniform << " :c"
+                << std::endl;
+    }
+  }
+}
+
+GLint Shader::getUniformLocation(UniformName name) const {
+  auto it = uniformLocations.find(name.hash);
+  return it == uniformLocations.end() ? -1 : it->second;
+}
+
+void Shader::bindUniformBlock(const char* blockName, GLuint binding) {
+  GLuint index = glGetUniformBlockIndex(shaderID, blockName);
+  if (index != GL_INVALID_INDEX)
+    glUniformBlockBinding(shaderID, index, binding);
+}
+
+void Shader::useShader() {
+  glUseProgram(shaderID);
+}
+
+void Shader::setBool(UniformName name, bool value) const {
+  glUniform1i(getUniformLocation(name), (int)value);
+}
+
+void Shader::setInt(UniformName name, int value) const {
+  glUniform1i(getUniformLocation(name), value);
+}
+
+void Shader::setFloat(UniformName name, float value) const {
+  glUniform1f(getUniformLocation(name), value);
+}
+
+void Shader::setIVec2(UniformName name, const glm::ivec2& value) const {
+  glUniform2iv(getUniformLocation(name), 1, &value[0]);
+}
+void Shader::setIVec3(UniformName name, const glm::ivec3& value) const {
+  glUniform3iv(getUniformLocation(name), 1, &value[0]);
+}
+void Shader::setIVec4(UniformName name, const glm::ivec4& value) const {
+  glUniform4iv(getUniformLocation(name), 1, &value[0]);
+}
+
+void Shader::setVec2(UniformName name, const glm::vec2& value) const {
+  glUniform2fv(getUniformLocation(name), 1, &value[0]);
+}
+void Shader::setVec2(UniformName name, float x, float y) const {
+  glUniform2f(getUniformLocation(name), x, y);
+}
+
+void Shader::setVec3(UniformName name, const glm::vec3& value) const {
+  glUniform3fv(getUniformLocation(name), 1, &value[0]);
+}
+void Shader::setVec3(UniformName name, float x, float y, float z) const {
+  glUniform3f(getUniformLocation(name), x, y, z);
+}
+
+void Shader::setVec4(UniformName name, const glm::vec4& value) const {
+  glUniform4fv(getUniformLocation(name), 1, &value[0]);
+}
+void Shader::setVec4(UniformName name,
+                     float x,
+                     float y,
+                     float z,
+                     float w) const {
+  glUniform4f(getUniformLocation(name), x, y, z, w);
+}
+
+void Shader::setMat2(UniformName name, const glm::mat2& mat) const {
+  glUniformMatrix2fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+}
+void Shader::setMat3(UniformName name, const glm::mat3& mat) const {
+  glUniformMatrix3fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::setMat4(UniformName name, const glm::mat4& mat) const {
+  glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+}
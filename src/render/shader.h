@@ -0,0 +1,111 @@
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// FNV-1a, used to key the uniform location cache
+constexpr uint32_t hashUniformName(std::string_view name) {
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Uniform name with its hash. String literals are hashed at compile time,
+// std::strings at runtime.
+struct UniformName {
+  uint32_t hash;
+
+  template <std::size_t N>
+  consteval UniformName(const char (&name)[N])
+      : hash(hashUniformName(std::string_view(name, N - 1))) {}
+  UniformName(const std::string& name) : hash(hashUniformName(name)) {}
+};
+
+class Shader {
+ public:
+  unsigned int shaderID;
+
+  enum class Build { Wait, Deferred };
+
+  // Builds the program from the two GLSL files, with a "#define NAME 1" for
+  // each of defines, or "#define NAME VALUE" for entries written NAME=VALUE.
+  // Linked programs are cached on disk as driver binaries and reused while
+  // sources and driver match.
+  // Build::Deferred only queues the compile, so several programs can build
+  // at once; finishBuild() must be called before the program is used.
+  Shader(const char* vertexSource,
+         const char* fragmentSource,
+         const std::vector<std::string>& defines = {},
+         Build build = Build::Wait);
+
+  // waits for a deferred build; no-op once built
+  void finishBuild();
+
+  void useShader();
+
+  // cached location, -1 if the uniform isn't active (glUniform ignores -1)
+  GLint getUniformLocation(UniformName name) const;
+
+  // attaches a uniform block to a shared binding point; no-op if unused
+  void bindUniformBlock(const char* blockName, GLuint binding);
+
+  void setBool(UniformName name, bool value) const;
+  void setInt(UniformName name, int value) const;
+  void setFloat(UniformName name, float value) const;
+  void setIVec2(UniformName name, const glm::ivec2& value) const;
+  void setIVec3(UniformName name, const glm::ivec3& value) const;
+  void setIVec4(UniformName name, const glm::ivec4& value) const;
+  void setVec2(UniformName name, const glm::vec2& value) const;
+  void setVec2(UniformName name, float x, float y) const;
+  void setVec3(UniformName name, const glm::vec3& value) const;
+  void setVec3(UniformName name, float x, float y, float z) const;
+  void setVec4(UniformName name, const glm::vec4& value) const;
+  void setVec4(UniformName name,
+               float x,
+               float y,
+               float z,
+               float w) const;
+
+  void setMat2(UniformName name, const glm::mat2& mat) const;
+  void setMat3(UniformName name, const glm::mat3& mat) const;
+  void setMat4(UniformName name, const glm::mat4& mat) const;
+
+ private:
+  // active uniforms, reflected once after linking
+  std::unordered_map<uint32_t, GLint> uniformLocations;
+
+  // build state, only needed until finishBuild()
+  std::string name;
+  std::string cacheFile;
+  uint64_t cacheKey = 0;
+  GLuint vertexStage = 0, fragmentStage = 0;
+  std::chrono::high_resolution_clock::time_point buildStart;
+  bool built = false;
+
+  static std::string readFile(const char* path);
+  static std::string injectDefines(const std::string& code,
+                                   const std::vector<std::string>& defines);
+  void startCompile(const char* vertexCode, const char* fragmentCode);
+  bool loadProgramBinary(const std::string& path,
+                         uint64_t key,
+                         float& compileMs);
+  void saveProgramBinary(const std::string& path,
+                         uint64_t key,
+                         float compileMs);
+
+  void reflectUniforms();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "shaderVariants.h"
+
+#include <iostream>
+#include <utility>
+
+ShaderVariants::ShaderVariants(std::string vertexPath,
+                               std::string fragmentPath,
+                               std::vector<std::string> features,
+                               Setup setup)
+    : vertexPath(std::move(vertexPath)),
+      fragmentPath(std::move(fragmentPath)),
+      features(std::move(features)),
+      setup(std::move(setup)) {}
+
+std::vector<std::string> ShaderVariants::definesFor(uint32_t mask) const {
+  std::vector<std::string> defines;
+  for (size_t i = 0; i < features.size(); i++) {
+    if (mask & (1u << i))
+      defines.push_back(features[i]);
+  }
+  if (mask >> features.size()) {
+    std::cerr << "shader variant " << mask << " uses unknown feature bits :c"
+              << std::endl;
+  }
+  return defines;
+}
+
+void ShaderVariants::prepare(const std::vector<uint32_t>& masks) {
+  // queue every compile first, then collect them
+  std::vector<Shader*> started;
+  for (uint32_t mask : masks) {
+    if (programs.count(mask))
+      continue;
+    auto program = std::make_unique<Shader>(
+        vertexPath.c_str(), fragmentPath.c_str(), definesFor(mask),
+        Shader::Build::Deferred);
+    started.push_back(program.get());
+    programs.emplace(mask, std::move(program));
+  }
+
+  for (Shader* program : started) {
+    program->finishBuild();
+    if (setup)
+      setup(*program);
+  }
+}
+
+Shader& ShaderVariants::get(uint32_t mask) {
+  auto it = programs.find(mask);
+  if (it != programs.end())
+    return *it->second;
+
+  prepare({mask});
+  return *programs.at(mask);
+}
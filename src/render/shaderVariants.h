@@ -0,0 +1,44 @@
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shader.h"
+
+// One vertex/fragment pair compiled into several programs, each specialized
+// with a different set of #defines, so the shaders can #ifdef features
+// instead of branching on uniforms. A variant is a bitmask over the feature
+// names given to the constructor: bit i defines features[i].
+class ShaderVariants {
+ public:
+  // runs once on every program after it's built, e.g. to bind blocks
+  using Setup = std::function<void(Shader&)>;
+
+  ShaderVariants(std::string vertexPath,
+                 std::string fragmentPath,
+                 std::vector<std::string> features,
+                 Setup setup = nullptr);
+
+  // Builds all the given variants side by side. With parallel shader compile
+  // the driver works on them at the same time; cached ones just load.
+  void prepare(const std::vector<uint32_t>& masks);
+
+  // the program for a variant, built on the spot if it wasn't prepared
+  Shader& get(uint32_t mask);
+
+ private:
+  std::vector<std::string> definesFor(uint32_t mask) const;
+
+  std::string vertexPath;
+  std::string fragmentPath;
+  std::vector<std::string> features;
+  Setup setup;
+  std::unordered_map<uint32_t, std::unique_ptr<Shader>> programs;
+};
+
+#endif
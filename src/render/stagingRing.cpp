@@ -0,0 +1,152 @@
+#include "stagingRing.h"
+
+#include "glExtensions.h"
+
+#include <iostream>
+
+// copies are issued with 4-byte source offsets, which both floats and indices
+// satisfy
+static GLintptr alignUp(GLintptr value) {
+  return (value + 3) & ~static_cast<GLintptr>(3);
+}
+
+StagingRing::StagingRing(GLsizeiptr capacity) : capacity(capacity) {
+  memory.set(capacity);
+  glGenBuffers(1, &buffer);
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+
+  if (GLExtensions::bufferStorage) {
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLExtensions::bufferStorage(GL_COPY_READ_BUFFER, capacity, nullptr, flags);
+    mapped = static_cast<uint8_t*>(
+        glMapBufferRange(GL_COPY_READ_BUFFER, 0, capacity, flags));
+    persistent = mapped != nullptr;
+  }
+
+  if (!persistent) {
+    // immutable storage can't be re-specified, so start over with a mutable
+    // buffer for the orphaning path
+    glDeleteBuffers(1, &buffer);
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBufferData(GL_COPY_READ_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  std::cout << "Staging ring: " << (capacity >> 20) << " MiB, "
+            << (persistent ? "persistent" : "orphaning") << "\n";
+}
+
+StagingRing::~StagingRing() {
+  for (Region& region : inFlight)
+    glDeleteSync(region.fence);
+
+  if (persistent) {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &buffer);
+}
+
+StagingRing::Allocation StagingRing::Allocate(GLsizeiptr size) {
+  Allocation alloc;
+  if (size <= 0 || size > capacity)
+    return alloc;
+
+  GLintptr offset = alignUp(head);
+  if (offset + size > capacity) {
+    // wrap around
+    FencePending();
+    offset = 0;
+    pendingBegin = 0;
+
+    if (!persistent) {
+      // orphan: the driver hands back fresh storage, old copies keep theirs
+      glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+      glBufferData(GL_COPY_READ_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+      glBindBuffer(GL_COPY_READ_BUFFER, 0);
+      for (Region& region : inFlight)
+        glDeleteSync(region.fence);
+      inFlight.clear();
+    }
+  }
+
+  if (persistent) {
+    WaitForRange(offset, offset + size);
+    alloc.ptr = mapped + offset;
+  } else {
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    alloc.ptr = static_cast<uint8_t*>(glMapBufferRange(
+        GL_COPY_READ_BUFFER, offset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+            GL_MAP_INVALIDATE_RANGE_BIT));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    if (!alloc.ptr)
+      return Allocation{};
+  }
+
+  alloc.offset = offset;
+  alloc.size = size;
+  head = offset + size;
+  return alloc;
+}
+
+void StagingRing::Submit(const Allocation& alloc,
+                         GLuint dstBuffer,
+                         GLintptr dstOffset) {
+  if (!alloc.ptr)
+    return;
+
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+  if (!persistent)
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, alloc.offset,
+                      dstOffset, alloc.size);
+  frameBytes += alloc.size;
+
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+void StagingRing::EndFrame() {
+  FencePending();
+  lastFrameBytes = frameBytes;
+  frameBytes = 0;
+}
+
+void StagingRing::FencePending() {
+  if (!persistent || head == pendingBegin)
+    return;
+  GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  inFlight.push_back({pendingBegin, head, fence});
+  pendingBegin = head;
+}
+
+// Blocks until no in-flight copy still reads from [begin, end). Fences signal
+// in submission order, so waiting on the newest overlapping one retires every
+// region before it as well.
+void StagingRing::WaitForRange(GLintptr begin, GLintptr end) {
+  size_t last = inFlight.size();
+  for (size_t i = 0; i < inFlight.size(); i++) {
+    if (inFlight[i].begin < end && begin < inFlight[i].end)
+      last = i;
+  }
+  if (last == inFlight.size())
+    return;
+
+  GLsync fence = inFlight[last].fence;
+  GLenum result = GL_TIMEOUT_EXPIRED;
+  while (result == GL_TIMEOUT_EXPIRED) {
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+  }
+  if (result == GL_WAIT_FAILED)
+    std::cerr << "staging ring fence wait failed :c\n";
+
+  for (size_t i = 0; i <= last; i++)
+    glDeleteSync(inFlight[i].fence);
+  inFlight.erase(inFlight.begin(), inFlight.begin() + last + 1);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <cstdint>
+#include <deque>
+
+#include "../core/memory_stats.h"
+
+// Streaming upload ring for mesh data.
+//
+// With GL 4.4 / ARB_buffer_storage the ring is mapped once, persistently and
+// coherently, and regions are recycled behind fences. On plain GL 3.3 it falls
+// back to orphaning: each allocation maps an unsynchronized range and the whole
+// buffer is re-specified when the ring wraps.
+//
+// Callers write into the pointer from Allocate() and then Submit() the region,
+// which only issues a GPU-side copy into the destination buffer.
+class StagingRing {
+ public:
+  struct Allocation {
+    uint8_t* ptr = nullptr;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+  };
+
+  explicit StagingRing(GLsizeiptr capacity);
+  ~StagingRing();
+
+  StagingRing(const StagingRing&) = delete;
+  StagingRing& operator=(const StagingRing&) = delete;
+
+  // Reserves size bytes of mapped memory. Returns an empty allocation if size
+  // exceeds the ring. In orphaning mode only one allocation may be open at a
+  // time, so Submit() it before allocating again.
+  Allocation Allocate(GLsizeiptr size);
+
+  // Copies a written allocation into dstBuffer at dstOffset.
+  void Submit(const Allocation& alloc, GLuint dstBuffer, GLintptr dstOffset);
+
+  // Fences everything submitted since the last call. Call once per frame after
+  // the uploads have been issued.
+  void EndFrame();
+
+  bool IsPersistent() const { return persistent; }
+  GLsizeiptr Capacity() const { return capacity; }
+
+  // bytes submitted between the last two EndFrame calls
+  GLsizeiptr SubmittedLastFrame() const { return lastFrameBytes; }
+
+ private:
+  struct Region {
+    GLintptr begin;
+    GLintptr end;
+    GLsync fence;
+  };
+
+  void FencePending();
+  void WaitForRange(GLintptr begin, GLintptr end);
+
+  GLuint buffer = 0;
+  GLsizeiptr capacity;
+  bool persistent = false;
+  uint8_t* mapped = nullptr;
+
+  GLintptr head = 0;
+  GLintptr pendingBegin = 0;
+  std::deque<Region> inFlight;
+
+  GLsizeiptr frameBytes = 0;
+  GLsizeiptr lastFrameBytes = 0;
+
+  MemoryTracker memory{MEMORY_STAGING};
+};
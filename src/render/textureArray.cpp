@@ -0,0 +1,142 @@
+#include "textureArray.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "../core/baked_texture.h"
+#include "../core/mapped_file.h"
+#include "glExtensions.h"
+
+TextureArray::TextureArray(const std::string& bakedPath,
+                           const std::string& atlasPath,
+                           int cellsPerSide) {
+  auto start = std::chrono::high_resolution_clock::now();
+
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+
+  const char* source = "baked";
+  if (!LoadBaked(bakedPath)) {
+    source = "png";
+    if (!LoadAtlas(atlasPath, cellsPerSide)) {
+      std::cout << "couldnt load texture atlas " << atlasPath
+                << " :c - using white default\n";
+      UploadFallback();
+      return;
+    }
+  }
+
+  auto end = std::chrono::high_resolution_clock::now();
+  std::cout << "Texture array loaded from " << source << " in "
+            << std::chrono::duration<double, std::milli>(end - start).count()
+            << " ms\n";
+}
+
+TextureArray::~TextureArray() {
+  if (texture != 0)
+    glDeleteTextures(1, &texture);
+}
+
+bool TextureArray::LoadBaked(const std::string& path) {
+  MappedFile file(path);
+  if (!file.isOpen())
+    return false;
+
+  const BakedTextureHeader* header =
+      readBakedTexture(file.data(), file.size());
+  if (!header) {
+    std::cout << "ignoring " << path << ", not a baked texture :c\n";
+    return false;
+  }
+  Upload(header, file.data());
+  return true;
+}
+
+// slow path for when the bake target hasn't run
+bool TextureArray::LoadAtlas(const std::string& path, int cellsPerSide) {
+  stbi_set_flip_vertically_on_load(false);
+  int width, height, channels;
+  unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+  if (!pixels)
+    return false;
+
+  std::vector<uint8_t> baked;
+  bool ok = bakeAtlas(pixels, width, height, cellsPerSide, baked);
+  stbi_image_free(pixels);
+  if (!ok)
+    return false;
+
+  Upload(readBakedTexture(baked.data(), baked.size()), baked.data());
+  return true;
+}
+
+void TextureArray::Upload(const BakedTextureHeader* header,
+                          const uint8_t* data) {
+  layers = static_cast<int>(header->layers);
+
+  const BakedMip* mips = bakedMips(header);
+  size_t bytes = 0;
+  for (uint32_t level = 0; level < header->mipLevels; level++) {
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8,
+                 std::max(header->width >> level, 1u),
+                 std::max(header->height >> level, 1u), layers, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, data + mips[level].offset);
+    bytes += mips[level].size;
+  }
+  memory.set(bytes);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL,
+                  header->mipLevels - 1);
+
+  // blocky up close, but distant faces read from the small mips
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+                  GL_NEAREST_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  // Ground seen at grazing angles stays sharp instead of blurring. Not on
+  // software rasterizers: llvmpipe filters anisotropically per pixel in
+  // software, which costs whole seconds per draw at grazing angles and makes
+  // headless runs useless.
+  const char* renderer =
+      reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+  const bool softwareRenderer =
+      renderer && (std::strstr(renderer, "llvmpipe") ||
+                   std::strstr(renderer, "softpipe"));
+  float anisotropy = 1.0f;
+  if (!softwareRenderer &&
+      (GLExtensions::hasVersion(4, 6) ||
+       GLExtensions::hasExtension("GL_EXT_texture_filter_anisotropic") ||
+       GLExtensions::hasExtension("GL_ARB_texture_filter_anisotropic"))) {
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &anisotropy);
+    anisotropy = std::min(anisotropy, 16.0f);
+    glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
+  }
+
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  std::cout << "Texture array: " << layers << " layers of " << header->width
+            << "x" << header->height << ", " << header->mipLevels << " mips, "
+            << anisotropy << "x anisotropy\n";
+}
+
+// a single white layer, so every layer index clamps to something visible
+void TextureArray::UploadFallback() {
+  const unsigned char white[] = {255, 255, 255, 255};
+  layers = 1;
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 1, 1, 1, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, white);
+  memory.set(sizeof(white));
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TextureArray::Bind(GLuint unit) const {
+  glActiveTexture(GL_TEXTURE0 + unit);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+}
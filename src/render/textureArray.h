@@ -0,0 +1,42 @@
+#pragma once
+#include <glad/glad.h>
+
+#include <string>
+
+#include "../core/memory_stats.h"
+
+struct BakedTextureHeader;
+
+// A texture atlas split into a GL_TEXTURE_2D_ARRAY with one layer per cell.
+// Each cell gets its own mip chain, so mip filtering never blends
+// neighbouring cells together the way it would inside a single 2D atlas.
+// Layer index = row * cellsPerSide + col, row 0 being the top row of the
+// image.
+//
+// Loads the container baked by the bake_textures tool when it exists: the
+// file is mmapped and every mip level is uploaded straight from it. Without
+// one it decodes the PNG and bakes it in memory first.
+class TextureArray {
+ public:
+  TextureArray(const std::string& bakedPath,
+               const std::string& atlasPath,
+               int cellsPerSide);
+  ~TextureArray();
+
+  TextureArray(const TextureArray&) = delete;
+  TextureArray& operator=(const TextureArray&) = delete;
+
+  void Bind(GLuint unit) const;
+
+  int Layers() const { return layers; }
+
+ private:
+  bool LoadBaked(const std::string& path);
+  bool LoadAtlas(const std::string& path, int cellsPerSide);
+  void Upload(const BakedTextureHeader* header, const uint8_t* data);
+  void UploadFallback();
+
+  GLuint texture = 0;
+  int layers = 0;
+  MemoryTracker memory{MEMORY_TEXTURES};
+};
@@ -0,0 +1,27 @@
+#include "uniformBuffer.h"
+
+UniformBuffer::UniformBuffer(GLsizeiptr size, GLuint binding) : size(size) {
+  glGenBuffers(1, &ubo);
+  glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+  glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
+}
+
+UniformBuffer::~UniformBuffer() {
+  glDeleteBuffers(1, &ubo);
+}
+
+void UniformBuffer::update(const void* data,
+                           GLsizeiptr dataSize,
+                           GLintptr offset) {
+  glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+  if (offset == 0 && dataSize == size) {
+    // whole-buffer update: orphan so we never wait on last frame's draws
+    glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+  } else {
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, dataSize, data);
+  }
+  glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
@@ -0,0 +1,38 @@
+#ifndef UNIFORM_BUFFER_H
+#define UNIFORM_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <glm/glm.hpp>
+
+// binding points shared by every program
+enum UniformBinding : GLuint {
+  FRAME_UNIFORMS_BINDING = 0,
+};
+
+// Per-frame constants, std140 layout. Must match the FrameData block in the
+// shaders.
+struct FrameUniforms {
+  glm::mat4 projection;
+  glm::mat4 view;           // relative to cameraOrigin
+  glm::ivec4 cameraOrigin;  // xyz used, w is padding
+  glm::vec4 fogColor;
+  glm::vec4 fogRange;  // x = start, y = end
+};
+
+class UniformBuffer {
+ public:
+  UniformBuffer(GLsizeiptr size, GLuint binding);
+  ~UniformBuffer();
+
+  UniformBuffer(const UniformBuffer&) = delete;
+  UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+  void update(const void* data, GLsizeiptr size, GLintptr offset = 0);
+
+ private:
+  GLuint ubo = 0;
+  GLsizeiptr size;
+};
+
+#endif
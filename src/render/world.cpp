@@ -3,6 +3,8 @@
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -13,279 +15,468 @@
 #include <tuple>
 #include <vector>
 
-#include "../core/shader.h"
+#include "../core/trace.h"
 #include "chunk.h"
-#include "perlinNoise.h"
-#include "stb_image/stb_image.h"
 #include "world.h"
 
-World::World() : chunkSize(16), chunkHeight(96), renderDistance(6) {
+World::World(int distance)
+    : chunkSize(16),
+      chunkHeight(96),
+      renderDistance(std::max(distance, 1)),
+      lodRadius(8),
+      lodSplitRadius(3),
+      terrain(chunkSize, chunkHeight),
+      stagingRing(8 * 1024 * 1024) {
   // Procedural generation active — heightmap loading disabled
-  // if (!LoadHeightmap("../assets/heightmaps/terrain.png")) {
+  // if (!terrain.LoadHeightmap("../assets/heightmaps/terrain.png")) {
   //   std::cerr << "Warning: Could not load heightmap, using procedural generation\n";
   // }
 
   std::cout << "Creating chunks with renderDistance=" << renderDistance << "\n";
-  int chunkCount = 0;
-  int minCoord = -static_cast<int>(renderDistance);
-  int maxCoord = static_cast<int>(renderDistance);
-
-  for (int x = minCoord; x <= maxCoord; x++) {
-    for (int z = minCoord; z <= maxCoord; z++) {
-      int y = 0;
-      std::tuple<int, int, int> chunkKey = std::make_tuple(x, y, z);
-      std::vector<unsigned int> chunkData = GenerateChunkData(x, y, z);
-      glm::vec3 position(x * chunkSize, y * chunkHeight, z * chunkSize);
-      chunks[chunkKey] =
-          std::make_unique<Chunk>(chunkSize, chunkHeight, chunkData, position);
-      chunkCount++;
-    }
-  }
-  std::cout << "Created " << chunkCount << " chunks\n";
+  SelectLod(0, 0);
+
+  for (const ChunkKey& key : neededChunks)
+    LoadChunk(std::get<0>(key), std::get<2>(key));
+  std::cout << "Created " << neededChunks.size() << " chunks\n";
+
+  for (const ChunkKey& key : neededLod)
+    LoadLodNode(std::get<0>(key), std::get<1>(key), std::get<2>(key));
+  std::cout << "Created " << neededLod.size() << " LOD nodes\n";
 
   // Rebuild all meshes now that all neighbors exist.
-  for (int x = minCoord; x <= maxCoord; x++) {
-    for (int z = minCoord; z <= maxCoord; z++) {
-      rebuildWithNeighbors(x, z);
-    }
-  }
+  for (const ChunkKey& key : neededChunks)
+    rebuildWithNeighbors(std::get<0>(key), std::get<2>(key));
+  for (const ChunkKey& key : neededLod)
+    rebuildLodWithNeighbors(std::get<0>(key), std::get<1>(key),
+                            std::get<2>(key));
+  stagingRing.EndFrame();
+
+  BuildDrawList();
 }
 
-World::~World() {
-  if (heightmapData) {
-    stbi_image_free(heightmapData);
-  }
+World::~World() {}
+
+// Returns the data array of a neighbor chunk, or nullptr if it doesn't exist.
+const std::vector<unsigned int>* World::getNeighborData(int cx, int cz) const {
+  auto it = chunks.find(std::make_tuple(cx, 0, cz));
+  if (it == chunks.end()) return nullptr;
+  return &it->second->getData();
 }
 
-std::vector<unsigned int> World::GenerateChunkData(int chunkX,
-                                                   int chunkY,
-                                                   int chunkZ) {
-  std::vector<unsigned int> data;
-  data.reserve(chunkSize * chunkSize * chunkHeight);
-
-  static bool debugPrinted = false;
-  int blockCount = 0;
-  float minHeight = 999.0f, maxHeight = -999.0f;
-
-  // Layout matches Chunk index formula: x + y*W + z*W*H → iterate z outer, y mid, x inner
-  for (int z = 0; z < chunkSize; z++) {
-    for (int y = 0; y < chunkHeight; y++) {
-      for (int x = 0; x < chunkSize; x++) {
-        float worldX = chunkX * chunkSize + x;
-        float worldZ = chunkZ * chunkSize + z;
-        float worldY = chunkY * chunkHeight + y;
-
-        float height;
-        if (heightmapData) {
-          height = SampleHeightmap(worldX, worldZ);
-          if (height < minHeight)
-            minHeight = height;
-          if (height > maxHeight)
-            maxHeight = height;
-        } else {
-          static PerlinNoise perlin;
-          float h = 0.0f;
-          float freq = 0.005f;
-          float amp  = 1.0f;
-          float maxAmp = 0.0f;
-          for (int octave = 0; octave < 7; ++octave) {
-            h += amp * perlin.noise(worldX * freq, worldZ * freq, 0.0f);
-            maxAmp += amp;
-            freq *= 2.0f;
-            amp  *= 0.4f;
-          }
-          h /= maxAmp;                   // normalize to [-1, 1]
-          h = (h + 1.0f) * 0.5f;        // remap to [0, 1]
-          // Plains below 0.4, hills/mountains above — tweak first value to taste
-          h = glm::smoothstep(0.35f, 0.75f, h);
-          height = 8.0f + h * 52.0f;
-          height = glm::clamp(height, 0.0f, static_cast<float>(chunkHeight - 1));
-        }
-
-        unsigned int blockType = 0;
-        if (worldY <= height) {
-          if (worldY > height - 1)
-            blockType = 1;  // grass
-          else if (worldY > height - 5)
-            blockType = 2;  // dirt
-          else
-            blockType = 3;  // stone
-          blockCount++;
-        }
-        data.push_back(blockType);
-      }
-    }
-  }
+void World::rebuildWithNeighbors(int cx, int cz) {
+  auto it = chunks.find(std::make_tuple(cx, 0, cz));
+  if (it == chunks.end()) return;
+  it->second->RebuildMesh(
+      getNeighborData(cx - 1, cz),
+      getNeighborData(cx + 1, cz),
+      getNeighborData(cx, cz - 1),
+      getNeighborData(cx, cz + 1));
+}
+
+// Same as getNeighborData, for LOD nodes of one level. Nodes at a different
+// level are never used for culling, so the border faces facing them stay and
+// act as skirts over the seam.
+const std::vector<unsigned int>* World::getLodNeighborData(int level,
+                                                           int nx,
+                                                           int nz) const {
+  auto it = lodChunks.find(std::make_tuple(level, nx, nz));
+  if (it == lodChunks.end()) return nullptr;
+  return &it->second->getData();
+}
 
-  if (!debugPrinted && chunkX == 0 && chunkZ == 0) {
-    std::cout << "DEBUG Chunk(0,0,0):\n";
-    std::cout << "  Blocks generated: " << blockCount << "\n";
-    std::cout << "  Height range: [" << minHeight << ", " << maxHeight << "]\n";
-    std::cout << "  Sample 4x4 heights:\n";
-    for (int sx = 0; sx < 4; sx++) {
-      for (int sz = 0; sz < 4; sz++) {
-        float h =
-            SampleHeightmap(static_cast<float>(sx), static_cast<float>(sz));
-        std::cout << h << (sz == 3 ? "\n" : " ");
-      }
+void World::rebuildLodWithNeighbors(int level, int nx, int nz) {
+  auto it = lodChunks.find(std::make_tuple(level, nx, nz));
+  if (it == lodChunks.end()) return;
+  it->second->RebuildMesh(
+      getLodNeighborData(level, nx - 1, nz),
+      getLodNeighborData(level, nx + 1, nz),
+      getLodNeighborData(level, nx, nz - 1),
+      getLodNeighborData(level, nx, nz + 1));
+}
+
+void World::LoadChunk(int cx, int cz) {
+  TRACE_ZONE("World::LoadChunk");
+  auto chunkData = terrain.GenerateChunkData(cx, 0, cz);
+  glm::vec3 position(cx * chunkSize, 0, cz * chunkSize);
+  chunks[std::make_tuple(cx, 0, cz)] = std::make_unique<Chunk>(
+      chunkSize, chunkHeight, chunkData, position, &stagingRing);
+}
+
+void World::LoadLodNode(int level, int nx, int nz) {
+  TRACE_ZONE("World::LoadLodNode");
+  const int cell = 1 << level;
+  auto nodeData = terrain.GenerateLodData(level, nx, nz);
+  glm::vec3 position(nx * chunkSize * cell, 0, nz * chunkSize * cell);
+  lodChunks[std::make_tuple(level, nx, nz)] = std::make_unique<Chunk>(
+      chunkSize, chunkHeight / cell, nodeData, position, &stagingRing, cell);
+}
+
+static int floorDiv(int value, int divisor) {
+  int q = value / divisor;
+  return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? q - 1 : q;
+}
+
+float World::ViewDistance() const {
+  // the camera can sit anywhere in its top-level node, plus the diagonal
+  const float topNodeSize = static_cast<float>(chunkSize << MAX_LOD_LEVEL);
+  return (lodRadius + 1) * topNodeSize * 1.5f;
+}
+
+glm::ivec4 World::VoxelBounds() const {
+  const int topNodeSize = chunkSize << MAX_LOD_LEVEL;
+  int cx = floorDiv(selectedChunkX, 1 << MAX_LOD_LEVEL);
+  int cz = floorDiv(selectedChunkZ, 1 << MAX_LOD_LEVEL);
+  return glm::ivec4((cx - lodRadius) * topNodeSize,
+                    (cz - lodRadius) * topNodeSize,
+                    (cx + lodRadius + 1) * topNodeSize,
+                    (cz + lodRadius + 1) * topNodeSize);
+}
+
+// A node splits while the camera chunk is within the split distance of it,
+// measured in chunks to the nearest chunk the node covers. Level 1 uses the
+// render distance, so every chunk within renderDistance gets full detail.
+// Coarser levels split at least twice as far as the level below so their
+// split regions stay nested.
+bool World::IsSplit(int level, int nx, int nz) const {
+  if (level == 0)
+    return false;
+  int radius = renderDistance;
+  for (int l = 2; l <= level; l++)
+    radius = std::max(radius * 2, lodSplitRadius << l);
+
+  const int span = 1 << level;
+  auto distance = [span](int node, int chunk) {
+    return std::max({0, node * span - chunk, chunk - (node * span + span - 1)});
+  };
+  return std::max(distance(nx, selectedChunkX), distance(nz, selectedChunkZ)) <=
+         radius;
+}
+
+void World::SetRenderDistance(int distance) {
+  distance = std::max(distance, 1);
+  if (distance == renderDistance)
+    return;
+  renderDistance = distance;
+  // reselect next Update; UnloadUnused then drops whatever fell outside
+  selectionValid = false;
+}
+
+// Walks the quadtree from the top ring down. The selected nodes tile the
+// ground around the camera without gaps or overlaps.
+void World::SelectLod(int camChunkX, int camChunkZ) {
+  TRACE_ZONE("World::SelectLod");
+  selectedChunkX = camChunkX;
+  selectedChunkZ = camChunkZ;
+  selectionValid = true;
+  neededChunks.clear();
+  neededLod.clear();
+
+  int cx = floorDiv(camChunkX, 1 << MAX_LOD_LEVEL);
+  int cz = floorDiv(camChunkZ, 1 << MAX_LOD_LEVEL);
+  for (int x = cx - lodRadius; x <= cx + lodRadius; x++) {
+    for (int z = cz - lodRadius; z <= cz + lodRadius; z++) {
+      SelectNode(MAX_LOD_LEVEL, x, z);
     }
-    debugPrinted = true;
   }
 
-  return data;
+  // stream in nearest first
+  auto distance2 = [&](const ChunkKey& key, int level) {
+    float size = static_cast<float>(1 << level);
+    float dx = (std::get<0>(key) + 0.5f) * size - (camChunkX + 0.5f);
+    float dz = (std::get<2>(key) + 0.5f) * size - (camChunkZ + 0.5f);
+    return dx * dx + dz * dz;
+  };
+  std::sort(neededChunks.begin(), neededChunks.end(),
+            [&](const ChunkKey& a, const ChunkKey& b) {
+              return distance2(a, 0) < distance2(b, 0);
+            });
+  std::sort(neededLod.begin(), neededLod.end(),
+            [&](const ChunkKey& a, const ChunkKey& b) {
+              return distance2({std::get<1>(a), 0, std::get<2>(a)},
+                               std::get<0>(a)) <
+                     distance2({std::get<1>(b), 0, std::get<2>(b)},
+                               std::get<0>(b));
+            });
+
+  neededChunkSet = std::unordered_set<ChunkKey, TupleHash>(
+      neededChunks.begin(), neededChunks.end());
+  neededLodSet = std::unordered_set<ChunkKey, TupleHash>(neededLod.begin(),
+                                                         neededLod.end());
+  if (trackLoadLatency)
+    TrackRequests();
 }
 
-bool World::LoadHeightmap(const char* path) {
-  int channels;
-  unsigned char* data =
-      stbi_load(path, &heightmapWidth, &heightmapHeight, &channels, 1);
+void World::TrackLoadLatency(bool enabled) {
+  trackLoadLatency = enabled;
+  chunkRequestedAt.clear();
+  lodRequestedAt.clear();
+  if (enabled)
+    TrackRequests();
+}
 
-  if (!data) {
-    std::cerr << "Failed to load heightmap: " << path << "\n";
-    return false;
+// Stamps newly needed, not yet loaded keys with the current Update and drops
+// the ones that were deselected before they ever loaded.
+void World::TrackRequests() {
+  auto track = [this](const std::vector<ChunkKey>& needed,
+                      const std::unordered_set<ChunkKey, TupleHash>& neededSet,
+                      const auto& loaded,
+                      std::unordered_map<ChunkKey, uint64_t, TupleHash>&
+                          requestedAt) {
+    for (auto it = requestedAt.begin(); it != requestedAt.end();) {
+      if (!neededSet.count(it->first))
+        it = requestedAt.erase(it);
+      else
+        ++it;
+    }
+    for (const ChunkKey& key : needed) {
+      if (!loaded.count(key))
+        requestedAt.emplace(key, updateCount);
+    }
+  };
+  track(neededChunks, neededChunkSet, chunks, chunkRequestedAt);
+  track(neededLod, neededLodSet, lodChunks, lodRequestedAt);
+}
+
+void World::SelectNode(int level, int nx, int nz) {
+  if (level == 0) {
+    neededChunks.push_back(std::make_tuple(nx, 0, nz));
+    return;
+  }
+  if (!IsSplit(level, nx, nz)) {
+    neededLod.push_back(std::make_tuple(level, nx, nz));
+    return;
   }
+  for (int i = 0; i < 4; i++)
+    SelectNode(level - 1, nx * 2 + (i & 1), nz * 2 + (i >> 1));
+}
 
-  heightmapData = data;
+// Appends the meshes covering a node. While meshes are still streaming in it
+// falls back to whatever complete coverage is loaded (the old coarser node or
+// its old finer children), so moving never opens holes in the ground. Returns
+// false if the node isn't fully covered; partial coverage is still appended.
+bool World::CollectNode(int level, int nx, int nz, std::vector<Chunk*>& out) {
+  Chunk* own = nullptr;
+  if (level == 0) {
+    auto it = chunks.find(std::make_tuple(nx, 0, nz));
+    if (it == chunks.end())
+      return false;
+    out.push_back(it->second.get());
+    return true;
+  }
 
-  // Debug: Check min/max values
-  unsigned char minVal = 255, maxVal = 0;
-  for (int i = 0; i < heightmapWidth * heightmapHeight; ++i) {
-    if (heightmapData[i] < minVal)
-      minVal = heightmapData[i];
-    if (heightmapData[i] > maxVal)
-      maxVal = heightmapData[i];
+  auto it = lodChunks.find(std::make_tuple(level, nx, nz));
+  if (it != lodChunks.end())
+    own = it->second.get();
+
+  if (own && !IsSplit(level, nx, nz)) {
+    out.push_back(own);
+    return true;
   }
-  heightmapMin = static_cast<int>(minVal);
-  heightmapMax = static_cast<int>(maxVal);
 
-  std::cout << "Loaded heightmap: " << path << " (" << heightmapWidth << "x"
-            << heightmapHeight << ")\n";
-  std::cout << "  PNG values: min=" << (int)minVal << " max=" << (int)maxVal
-            << "\n";
+  size_t mark = out.size();
+  bool complete = true;
+  for (int i = 0; i < 4; i++)
+    complete &= CollectNode(level - 1, nx * 2 + (i & 1), nz * 2 + (i >> 1), out);
+  if (complete || !own)
+    return complete;
+
+  out.resize(mark);
+  out.push_back(own);
   return true;
 }
 
-float World::SampleHeightmap(float worldX, float worldZ) {
-  if (!heightmapData || heightmapWidth == 0 || heightmapHeight == 0) {
-    return 0.0f;
+void World::BuildDrawList() {
+  TRACE_ZONE("World::BuildDrawList");
+  std::vector<Chunk*> visible;
+  int cx = floorDiv(selectedChunkX, 1 << MAX_LOD_LEVEL);
+  int cz = floorDiv(selectedChunkZ, 1 << MAX_LOD_LEVEL);
+  for (int x = cx - lodRadius; x <= cx + lodRadius; x++) {
+    for (int z = cz - lodRadius; z <= cz + lodRadius; z++) {
+      CollectNode(MAX_LOD_LEVEL, x, z, visible);
+    }
   }
 
-  // Muestreo directo del heightmap: cada pixel ~1 bloque
-  const float PIXEL_SCALE = 1.0f;
-  float u = worldX / PIXEL_SCALE;
-  float v = worldZ / PIXEL_SCALE;
-
-  // Wrap coordinates to repeat the heightmap seamlessly
-  u = std::fmod(u, static_cast<float>(heightmapWidth));
-  v = std::fmod(v, static_cast<float>(heightmapHeight));
-
-  if (u < 0)
-    u += heightmapWidth;
-  if (v < 0)
-    v += heightmapHeight;
-
-  // Bilinear interpolation
-  int x0 = static_cast<int>(u);
-  int z0 = static_cast<int>(v);
-  int x1 = (x0 + 1) % heightmapWidth;
-  int z1 = (z0 + 1) % heightmapHeight;
-
-  float fx = u - x0;  // fractional part
-  float fz = v - z0;
-
-  auto sampleNorm = [&](int px, int pz) {
-    unsigned char pv = heightmapData[pz * heightmapWidth + px];
-    int range = heightmapMax - heightmapMin;
-    float norm = 0.0f;
-    if (range > 0)
-      norm = (static_cast<int>(pv) - heightmapMin) / static_cast<float>(range);
-    return norm * HEIGHT_SCALE;
-  };
+  drawOrder.clear();
+  for (Chunk* chunk : visible)
+    drawOrder.push_back({chunk, 0.0f});
+  drawListDirty = false;
+  drawOrderSorted = false;
+}
 
-  float h00 = sampleNorm(x0, z0);
-  float h10 = sampleNorm(x1, z0);
-  float h01 = sampleNorm(x0, z1);
-  float h11 = sampleNorm(x1, z1);
+// Drops everything that is neither selected nor standing in for a node that
+// is still streaming in.
+void World::UnloadUnused() {
+  TRACE_ZONE("World::UnloadUnused");
+  std::unordered_set<const Chunk*> drawn;
+  for (const DrawEntry& entry : drawOrder)
+    drawn.insert(entry.chunk);
 
-  // Interpolación suavizada con smoothstep para reducir peldaños
-  auto smooth = [](float t) { return t * t * (3.0f - 2.0f * t); };
-  float sx = smooth(fx);
-  float sz = smooth(fz);
+  // Safe iteration with erase
+  for (auto it = chunks.begin(); it != chunks.end();) {
+    if (!neededChunkSet.count(it->first) && !drawn.count(it->second.get())) {
+      it = chunks.erase(it);  // erase returns iterator to next element
+    } else {
+      ++it;
+    }
+  }
 
-  float h0 = h00 * (1.0f - sx) + h10 * sx;
-  float h1 = h01 * (1.0f - sx) + h11 * sx;
-  float height = h0 * (1.0f - sz) + h1 * sz;
+  std::vector<ChunkKey> removed;
+  for (auto it = lodChunks.begin(); it != lodChunks.end();) {
+    if (!neededLodSet.count(it->first) && !drawn.count(it->second.get())) {
+      removed.push_back(it->first);
+      it = lodChunks.erase(it);
+    } else {
+      ++it;
+    }
+  }
 
-  if (height < 0.0f)
-    height = 0.0f;
-  if (height > chunkHeight - 1)
-    height = static_cast<float>(chunkHeight - 1);
+  // neighbors of a removed node now border a seam and need their skirts back
+  for (const ChunkKey& key : removed) {
+    auto [level, nx, nz] = key;
+    rebuildLodWithNeighbors(level, nx - 1, nz);
+    rebuildLodWithNeighbors(level, nx + 1, nz);
+    rebuildLodWithNeighbors(level, nx, nz - 1);
+    rebuildLodWithNeighbors(level, nx, nz + 1);
+  }
+}
 
-  return height;
+// Chunk origins come from a per-instance attribute in each chunk's VAO and
+// the camera lives in the FrameData UBO, so no uniforms are set per chunk.
+void World::Render(const glm::vec3& cameraPos, Chunk::DrawStats* stats) {
+  TRACE_ZONE("World::Render");
+  SortDrawOrder(cameraPos);
+  for (const DrawEntry& entry : drawOrder) {
+    entry.chunk->Render(cameraPos, stats);
+  }
 }
 
-// Returns the data array of a neighbor chunk, or nullptr if it doesn't exist.
-const std::vector<unsigned int>* World::getNeighborData(int cx, int cz) const {
-  auto it = chunks.find(std::make_tuple(cx, 0, cz));
-  if (it == chunks.end()) return nullptr;
-  return &it->second->getData();
+World::Stats World::CollectStats() const {
+  Stats stats;
+  stats.uploadedBytes = stagingRing.SubmittedLastFrame();
+  stats.chunksLoaded = static_cast<int>(chunks.size());
+  stats.lodLoaded = static_cast<int>(lodChunks.size());
+  for (const ChunkKey& key : neededChunks)
+    stats.chunksPending += chunks.count(key) == 0;
+  for (const ChunkKey& key : neededLod)
+    stats.lodPending += lodChunks.count(key) == 0;
+  return stats;
 }
 
-void World::rebuildWithNeighbors(int cx, int cz) {
-  auto it = chunks.find(std::make_tuple(cx, 0, cz));
-  if (it == chunks.end()) return;
-  it->second->RebuildMesh(
-      getNeighborData(cx - 1, cz),
-      getNeighborData(cx + 1, cz),
-      getNeighborData(cx, cz - 1),
-      getNeighborData(cx, cz + 1));
+bool World::WriteMemoryCsv(const std::string& path) const {
+  std::ofstream file(path, std::ios::trunc);
+  if (!file) {
+    std::cerr << "couldnt write memory report " << path << " :c" << std::endl;
+    return false;
+  }
+
+  // Keys are turned into (level, x, z), full-detail chunks being level 0.
+  // Sorted, so two dumps of the same view diff cleanly.
+  std::vector<std::pair<ChunkKey, const Chunk*>> rows;
+  rows.reserve(chunks.size() + lodChunks.size());
+  for (const auto& [key, chunk] : chunks)
+    rows.push_back({{0, std::get<0>(key), std::get<2>(key)}, chunk.get()});
+  for (const auto& [key, node] : lodChunks)
+    rows.push_back({key, node.get()});
+  std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  file << "level,x,z,voxel_bytes,cpu_mesh_bytes,gpu_mesh_bytes\n";
+  for (const auto& [key, chunk] : rows) {
+    file << std::get<0>(key) << "," << std::get<1>(key) << ","
+         << std::get<2>(key) << "," << chunk->VoxelBytes() << ","
+         << chunk->CpuMeshBytes() << "," << chunk->GpuMeshBytes() << "\n";
+  }
+  return static_cast<bool>(file);
 }
 
-void World::Render(Shader& shader) {
-  for (auto& [key, chunk] : chunks) {
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), chunk->position);
-    shader.setMat4("model", model);
-    chunk->Render(model);
+// Orders chunks front to back so early-Z rejects hidden fragments. A freshly
+// built list is fully sorted; otherwise last frame's order is nearly sorted
+// and insertion sort runs in about linear time.
+void World::SortDrawOrder(const glm::vec3& cameraPos) {
+  TRACE_ZONE("World::SortDrawOrder");
+  for (DrawEntry& entry : drawOrder) {
+    glm::vec3 d = entry.chunk->Center() - cameraPos;
+    entry.distance2 = glm::dot(d, d);
+  }
+
+  if (!drawOrderSorted) {
+    std::sort(drawOrder.begin(), drawOrder.end(),
+              [](const DrawEntry& a, const DrawEntry& b) {
+                return a.distance2 < b.distance2;
+              });
+    drawOrderSorted = true;
+    return;
+  }
+
+  for (size_t i = 1; i < drawOrder.size(); i++) {
+    DrawEntry entry = drawOrder[i];
+    size_t j = i;
+    while (j > 0 && drawOrder[j - 1].distance2 > entry.distance2) {
+      drawOrder[j] = drawOrder[j - 1];
+      j--;
+    }
+    drawOrder[j] = entry;
   }
 }
 
 void World::Update(float camX, float camY, float camZ, unsigned int modelLoc) {
+  TRACE_ZONE("World::Update");
   int currentChunkX = static_cast<int>(
       std::floor(static_cast<double>(camX) / static_cast<double>(chunkSize)));
   int currentChunkZ = static_cast<int>(
       std::floor(static_cast<double>(camZ) / static_cast<double>(chunkSize)));
 
+  if (!selectionValid || currentChunkX != selectedChunkX ||
+      currentChunkZ != selectedChunkZ) {
+    SelectLod(currentChunkX, currentChunkZ);
+    drawListDirty = true;
+  }
+
   int chunksLoadedThisFrame = 0;
-  for (int x = currentChunkX - static_cast<int>(renderDistance);
-       x <= currentChunkX + static_cast<int>(renderDistance); x++) {
-    for (int z = currentChunkZ - static_cast<int>(renderDistance);
-         z <= currentChunkZ + static_cast<int>(renderDistance); z++) {
-      std::tuple<int, int, int> key = std::make_tuple(x, 0, z);
-      if (chunks.find(key) == chunks.end()) {
-        if (chunksLoadedThisFrame >= 1) continue;  // defer to next frame
-        auto chunkData = GenerateChunkData(x, 0, z);
-        glm::vec3 position(x * chunkSize, 0, z * chunkSize);
-        chunks[key] = std::make_unique<Chunk>(chunkSize, chunkHeight, chunkData,
-                                              position);
-        rebuildWithNeighbors(x, z);
-        rebuildWithNeighbors(x - 1, z);
-        rebuildWithNeighbors(x + 1, z);
-        rebuildWithNeighbors(x, z - 1);
-        rebuildWithNeighbors(x, z + 1);
-        chunksLoadedThisFrame++;
-      }
+  for (const ChunkKey& key : neededChunks) {
+    if (chunks.find(key) != chunks.end())
+      continue;
+    if (chunksLoadedThisFrame >= 1) break;  // defer to next frame
+    auto [x, y, z] = key;
+    LoadChunk(x, z);
+    if (auto it = chunkRequestedAt.find(key); it != chunkRequestedAt.end()) {
+      chunkLoadLatencies.push_back(static_cast<int>(updateCount - it->second));
+      chunkRequestedAt.erase(it);
     }
+    rebuildWithNeighbors(x, z);
+    rebuildWithNeighbors(x - 1, z);
+    rebuildWithNeighbors(x + 1, z);
+    rebuildWithNeighbors(x, z - 1);
+    rebuildWithNeighbors(x, z + 1);
+    chunksLoadedThisFrame++;
+    drawListDirty = true;
   }
 
-  // Safe iteration with erase
-  for (auto it = chunks.begin(); it != chunks.end();) {
-    int chunkX = std::get<0>(it->first);
-    int chunkZ = std::get<2>(it->first);
-    if (std::abs(chunkX - currentChunkX) > static_cast<int>(renderDistance) ||
-        std::abs(chunkZ - currentChunkZ) > static_cast<int>(renderDistance)) {
-      it = chunks.erase(it);  // erase returns iterator to next element
-    } else {
-      ++it;
+  int lodLoadedThisFrame = 0;
+  for (const ChunkKey& key : neededLod) {
+    if (lodChunks.find(key) != lodChunks.end())
+      continue;
+    if (lodLoadedThisFrame >= LOD_LOADS_PER_FRAME) break;
+    auto [level, x, z] = key;
+    LoadLodNode(level, x, z);
+    if (auto it = lodRequestedAt.find(key); it != lodRequestedAt.end()) {
+      lodLoadLatencies.push_back(static_cast<int>(updateCount - it->second));
+      lodRequestedAt.erase(it);
     }
+    rebuildLodWithNeighbors(level, x, z);
+    rebuildLodWithNeighbors(level, x - 1, z);
+    rebuildLodWithNeighbors(level, x + 1, z);
+    rebuildLodWithNeighbors(level, x, z - 1);
+    rebuildLodWithNeighbors(level, x, z + 1);
+    lodLoadedThisFrame++;
+    drawListDirty = true;
+  }
+  stagingRing.EndFrame();
+
+  if (drawListDirty) {
+    BuildDrawList();
+    UnloadUnused();
   }
+  updateCount++;
 }
@@ -7,13 +7,17 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <memory>
+#include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <cstdint>
 #include <cstring>
-#include "../core/shader.h"
+#include "../world/terrain.h"
 #include "chunk.h"
+#include "stagingRing.h"
 
 struct TupleHash {
   std::size_t operator()(const std::tuple<int, int, int>& key) const {
@@ -29,39 +33,129 @@ struct TupleHash {
 
 class World {
  public:
-  World();
+  explicit World(int renderDistance = 6);
   ~World();
 
-  void Render(Shader& shader);
+  // Draws with whatever program is bound. stats, if given, adds up what this
+  // pass drew.
+  void Render(const glm::vec3& cameraPos, Chunk::DrawStats* stats = nullptr);
   void Update(float camX, float camY, float camZ, unsigned int modelLoc);
 
+  // Full-detail radius in chunks. Changing it reselects on the next Update,
+  // which loads and unloads chunks to match.
+  void SetRenderDistance(int distance);
+  int RenderDistance() const { return renderDistance; }
+
+  // distance to the edge of the coarsest LOD ring, for the far plane
+  float ViewDistance() const;
+
+  // (minX, minZ, maxX, maxZ) of the ground covered by voxel terrain
+  glm::ivec4 VoxelBounds() const;
+
+  // While enabled, every chunk and LOD node streamed in by Update records how
+  // many Update calls passed between it being selected and it being loaded.
+  void TrackLoadLatency(bool enabled);
+  const std::vector<int>& ChunkLoadLatencies() const {
+    return chunkLoadLatencies;
+  }
+  const std::vector<int>& LodLoadLatencies() const {
+    return lodLoadLatencies;
+  }
+
+  // Streaming counters for the performance HUD. Walks the selection, so
+  // only call it while something displays the result.
+  struct Stats {
+    int chunksLoaded = 0;
+    int chunksPending = 0;  // selected but not streamed in yet
+    int lodLoaded = 0;
+    int lodPending = 0;
+    size_t uploadedBytes = 0;  // through the staging ring, last Update
+  };
+  Stats CollectStats() const;
+
+  // One CSV row per loaded chunk and LOD node with the bytes it holds; the
+  // per-subsystem totals are in MemoryStats.
+  bool WriteMemoryCsv(const std::string& path) const;
+
+  // surface height of the terrain column at a world position
+  float TerrainHeight(float worldX, float worldZ) {
+    return terrain.Height(worldX, worldZ);
+  }
+
  private:
-  std::vector<unsigned int> GenerateChunkData(int chunkX,
-                                              int chunkY,
-                                              int chunkZ);
+  using ChunkKey = std::tuple<int, int, int>;
 
   int chunkSize;
   int chunkHeight;
   int renderDistance;
 
-  // Heightmap data
-  unsigned char* heightmapData = nullptr;
-  int heightmapWidth = 0;
-  int heightmapHeight = 0;
-  const float HEIGHT_SCALE = 60.0f;  // Pixel [0,255] maps to height [0,60]
+  // LOD rings. Past the full-detail chunks the ground is covered by nodes of
+  // 16x16 cells, where a level-L cell is 2^L blocks on each side. Nodes form
+  // a quadtree: a node near the camera is split into its four children,
+  // anything else is drawn at its own level.
+  static constexpr int MAX_LOD_LEVEL = 3;
+  static constexpr int LOD_LOADS_PER_FRAME = 2;
+  int lodRadius;        // ring of top-level nodes kept around the camera
+  int lodSplitRadius;   // minimum split distance for levels >= 2, in that level's nodes
 
-  int heightmapMin = 0;
-  int heightmapMax = 255;
+  Terrain terrain;
 
-  bool LoadHeightmap(const char* path);
-  float SampleHeightmap(float worldX, float worldZ);
   const std::vector<unsigned int>* getNeighborData(int cx, int cz) const;
   void rebuildWithNeighbors(int cx, int cz);
+  const std::vector<unsigned int>* getLodNeighborData(int level,
+                                                      int nx,
+                                                      int nz) const;
+  void rebuildLodWithNeighbors(int level, int nx, int nz);
+
+  void LoadChunk(int cx, int cz);
+  void LoadLodNode(int level, int nx, int nz);
+  void UnloadUnused();
+
+  bool IsSplit(int level, int nx, int nz) const;
+  void SelectLod(int camChunkX, int camChunkZ);
+  void SelectNode(int level, int nx, int nz);
+  bool CollectNode(int level, int nx, int nz, std::vector<Chunk*>& out);
+  void BuildDrawList();
+  void SortDrawOrder(const glm::vec3& cameraPos);
+
+  // shared upload ring for all chunk meshes
+  StagingRing stagingRing;
 
   std::unordered_map<std::tuple<int, int, int>,
                      std::unique_ptr<Chunk>,
                      TupleHash>
       chunks;
+
+  // LOD nodes keyed by (level, x, z)
+  std::unordered_map<ChunkKey, std::unique_ptr<Chunk>, TupleHash> lodChunks;
+
+  // current selection, nearest first
+  int selectedChunkX = 0;
+  int selectedChunkZ = 0;
+  bool selectionValid = false;
+  std::vector<ChunkKey> neededChunks;
+  std::vector<ChunkKey> neededLod;
+  std::unordered_set<ChunkKey, TupleHash> neededChunkSet;
+  std::unordered_set<ChunkKey, TupleHash> neededLodSet;
+
+  // Front-to-back draw list. Kept between frames so the insertion sort only
+  // has to fix up the few chunks the camera moved past.
+  struct DrawEntry {
+    Chunk* chunk;
+    float distance2;
+  };
+  std::vector<DrawEntry> drawOrder;
+  bool drawListDirty = true;
+  bool drawOrderSorted = false;
+
+  // load latency tracking, keys map to the Update call that first needed them
+  bool trackLoadLatency = false;
+  uint64_t updateCount = 0;
+  std::unordered_map<ChunkKey, uint64_t, TupleHash> chunkRequestedAt;
+  std::unordered_map<ChunkKey, uint64_t, TupleHash> lodRequestedAt;
+  std::vector<int> chunkLoadLatencies;
+  std::vector<int> lodLoadLatencies;
+  void TrackRequests();
 };
 
 #endif  // WORLD_H
@@ -0,0 +1,272 @@
+#include "chunkMesh.h"
+#include "../core/scratch_arena.h"
+#include "../core/trace.h"
+#include "texture.h"
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+ChunkMesh::ChunkMesh(unsigned int chunkWidth,
+                     unsigned int chunkHeight,
+                     const std::vector<unsigned int>& chunkData)
+    : chunkWidth(chunkWidth), chunkHeight(chunkHeight), chunkData(chunkData) {
+  blocks.resize(chunkWidth,
+                std::vector<std::vector<uint8_t>>(
+                    chunkHeight, std::vector<uint8_t>(chunkWidth, 0)));
+
+  GenerateChunkTerrain();
+}
+
+void ChunkMesh::GenerateChunkTerrain() {
+  TRACE_ZONE("ChunkMesh::GenerateChunkTerrain");
+  // Use chunkData from constructor (already populated with heightmap values)
+  for (unsigned int x = 0; x < chunkWidth; x++) {
+    for (unsigned int y = 0; y < chunkHeight; y++) {
+      for (unsigned int z = 0; z < chunkWidth; z++) {
+        unsigned int index = x + y * chunkWidth + z * chunkWidth * chunkHeight;
+        blocks[x][y][z] = static_cast<uint8_t>(chunkData[index]);
+      }
+    }
+  }
+  // the flat ids plus the nested block arrays, counting every inner vector
+  voxelMemory.set(chunkData.capacity() * sizeof(unsigned int) +
+                  chunkWidth * sizeof(blocks[0]) +
+                  chunkWidth * chunkHeight *
+                      (sizeof(blocks[0][0]) + chunkWidth * sizeof(uint8_t)));
+  GenerateChunkMesh();  // no neighbors yet on first build
+}
+
+// One quad per direction: corner offsets from the block's min corner and the
+// UV at each corner, in the winding the index pattern below expects.
+// Indexed by Face, so emitting a face is the block position plus constants.
+struct FaceTemplate {
+  float normal[3];
+  float corners[4][3];
+  float uvs[4][2];
+};
+
+static constexpr FaceTemplate FACE_TEMPLATES[FACE_COUNT] = {
+    // FACE_POS_X
+    {{1, 0, 0},
+     {{1, 0, 1}, {1, 0, 0}, {1, 1, 0}, {1, 1, 1}},
+     {{0, 0}, {1, 0}, {1, 1}, {0, 1}}},
+    // FACE_NEG_X
+    {{-1, 0, 0},
+     {{0, 0, 0}, {0, 0, 1}, {0, 1, 1}, {0, 1, 0}},
+     {{0, 0}, {1, 0}, {1, 1}, {0, 1}}},
+    // FACE_POS_Y
+    {{0, 1, 0},
+     {{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}},
+     {{0, 0}, {1, 0}, {1, 1}, {0, 1}}},
+    // FACE_NEG_Y, v flipped so the texture isn't mirrored from below
+    {{0, -1, 0},
+     {{0, 0, 0}, {1, 0, 0}, {1, 0, 1}, {0, 0, 1}},
+     {{0, 1}, {1, 1}, {1, 0}, {0, 0}}},
+    // FACE_POS_Z
+    {{0, 0, 1},
+     {{1, 0, 1}, {0, 0, 1}, {0, 1, 1}, {1, 1, 1}},
+     {{0, 0}, {1, 0}, {1, 1}, {0, 1}}},
+    // FACE_NEG_Z
+    {{0, 0, -1},
+     {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}},
+     {{0, 0}, {1, 0}, {1, 1}, {0, 1}}},
+};
+
+// two triangles over corners 0-1-2 and 2-3-0
+static constexpr unsigned int QUAD_INDICES[6] = {0, 1, 2, 2, 3, 0};
+
+// Calls fn(std::integral_constant<Face, F>) for every direction, unrolled, so
+// the body sees F as a constant and picks its template at compile time.
+template <typename Fn>
+static void forEachFace(Fn&& fn) {
+  [&]<int... F>(std::integer_sequence<int, F...>) {
+    (fn(std::integral_constant<Face, static_cast<Face>(F)>{}), ...);
+  }(std::make_integer_sequence<int, FACE_COUNT>{});
+}
+
+// Per-call scratch for the mesher: the padded block grid and the face masks.
+static thread_local ScratchArena meshArena;
+
+// Output buffers returned by ReleaseMesh. Chunks are meshed and uploaded one
+// at a time, so a couple of spares per thread is all streaming ever needs.
+struct MeshBuffers {
+  std::vector<ChunkMesh::Vertex> vertices;
+  std::vector<unsigned int> indices;
+};
+static constexpr size_t MESH_POOL_SIZE = 2;
+static thread_local std::vector<MeshBuffers> meshPool;
+static thread_local MemoryTracker meshPoolMemory{MEMORY_CACHES};
+
+static void trackMeshPool() {
+  size_t bytes = 0;
+  for (const MeshBuffers& buffers : meshPool)
+    bytes += buffers.vertices.capacity() * sizeof(ChunkMesh::Vertex) +
+             buffers.indices.capacity() * sizeof(unsigned int);
+  meshPoolMemory.set(bytes);
+}
+
+// Two passes over the chunk. The first copies the blocks into a grid padded
+// by one cell on every side, filled from the neighbors' border planes (or
+// air), so every visibility test is the same six loads with no edge cases.
+// It keeps a mask of visible faces per block and counts them per direction.
+// With the counts known the output is sized exactly once and the second pass
+// writes each face straight to its place in its direction's bucket.
+void ChunkMesh::GenerateChunkMesh(
+    const std::vector<unsigned int>* negX,
+    const std::vector<unsigned int>* posX,
+    const std::vector<unsigned int>* negZ,
+    const std::vector<unsigned int>* posZ) {
+  TRACE_ZONE("ChunkMesh::GenerateChunkMesh");
+  const int W = static_cast<int>(chunkWidth);
+  const int H = static_cast<int>(chunkHeight);
+
+  // padded cell (x, y, z) for x, z in [-1, W] and y in [-1, H], z fastest
+  const int PW = W + 2;
+  const int PH = H + 2;
+  const int strideY = PW;
+  const int strideX = PH * PW;
+
+  meshArena.reset();
+  uint8_t* padded = meshArena.allocate<uint8_t>(PW * PH * PW);
+  uint8_t* faceMasks = meshArena.allocate<uint8_t>(W * H * W);
+  std::memset(padded, 0, PW * PH * PW);
+
+  auto cell = [&](int x, int y, int z) -> uint8_t& {
+    return padded[(x + 1) * strideX + (y + 1) * strideY + (z + 1)];
+  };
+  auto neighbor = [W, H](const std::vector<unsigned int>* data, int x, int y,
+                         int z) -> uint8_t {
+    return (*data)[x + y * W + z * W * H] != 0;
+  };
+  for (int x = 0; x < W; x++) {
+    for (int y = 0; y < H; y++) {
+      const uint8_t* column = blocks[x][y].data();
+      std::memcpy(&cell(x, y, 0), column, W);
+      if (negZ)
+        cell(x, y, -1) = neighbor(negZ, x, y, W - 1);
+      if (posZ)
+        cell(x, y, W) = neighbor(posZ, x, y, 0);
+    }
+  }
+  for (int y = 0; y < H; y++) {
+    for (int z = 0; z < W; z++) {
+      if (negX)
+        cell(-1, y, z) = neighbor(negX, W - 1, y, z);
+      if (posX)
+        cell(W, y, z) = neighbor(posX, 0, y, z);
+    }
+  }
+
+  // same bit order as Face
+  const int NEIGHBOR_OFFSETS[FACE_COUNT] = {strideX, -strideX, strideY,
+                                            -strideY, 1,       -1};
+  unsigned int faceCounts[FACE_COUNT] = {};
+  int voxel = 0;
+  for (int x = 0; x < W; x++) {
+    for (int y = 0; y < H; y++) {
+      const uint8_t* row = &cell(x, y, 0);
+      for (int z = 0; z < W; z++, voxel++) {
+        uint8_t mask = 0;
+        if (row[z]) {
+          for (int face = 0; face < FACE_COUNT; face++) {
+            const uint8_t open = row[z + NEIGHBOR_OFFSETS[face]] == 0;
+            mask |= open << face;
+            faceCounts[face] += open;
+          }
+        }
+        faceMasks[voxel] = mask;
+      }
+    }
+  }
+
+  // buckets back to back, in Face order
+  unsigned int totalFaces = 0;
+  unsigned int nextFace[FACE_COUNT];
+  for (int face = 0; face < FACE_COUNT; face++) {
+    nextFace[face] = totalFaces;
+    buckets[face].firstIndex = totalFaces * 6;
+    buckets[face].indexCount = faceCounts[face] * 6;
+    totalFaces += faceCounts[face];
+  }
+
+  if (vertices.capacity() == 0 && !meshPool.empty()) {
+    vertices = std::move(meshPool.back().vertices);
+    indices = std::move(meshPool.back().indices);
+    meshPool.pop_back();
+    trackMeshPool();
+  }
+  // every element is written below, so only growth pays for the fill
+  vertices.resize(totalFaces * 4);
+  indices.resize(totalFaces * 6);
+
+  voxel = 0;
+  for (int x = 0; x < W; x++) {
+    for (int y = 0; y < H; y++) {
+      const uint8_t* row = &cell(x, y, 0);
+      for (int z = 0; z < W; z++, voxel++) {
+        const uint8_t mask = faceMasks[voxel];
+        if (!mask)
+          continue;
+        forEachFace([&](auto face) {
+          constexpr Face F = decltype(face)::value;
+          if (!(mask & (1 << F)))
+            return;
+          const unsigned int slot = nextFace[F]++;
+          AddFace<F>(vertices.data() + slot * 4,
+                     indices.data() + slot * 6, slot * 4, x, y, z,
+                     getBlockFace(row[z], F == FACE_POS_Y, F == FACE_NEG_Y));
+        });
+      }
+    }
+  }
+
+  meshMemory.set(vertices.capacity() * sizeof(Vertex) +
+                 indices.capacity() * sizeof(unsigned int));
+}
+
+void ChunkMesh::ReleaseMesh() {
+  if (meshPool.size() < MESH_POOL_SIZE) {
+    meshPool.push_back({std::move(vertices), std::move(indices)});
+    trackMeshPool();
+  }
+  // moved-from vectors are only valid, not necessarily empty
+  std::vector<Vertex>().swap(vertices);
+  std::vector<unsigned int>().swap(indices);
+  meshMemory.set(0);
+}
+
+// Straight stores of constants plus the block position: the corner loop has
+// a fixed trip count over constexpr data and unrolls completely, and every
+// direction is its own instantiation, so nothing branches on the face.
+template <Face F>
+void ChunkMesh::AddFace(Vertex* vertex,
+                        unsigned int* index,
+                        unsigned int baseVertex,
+                        int x,
+                        int y,
+                        int z,
+                        const BlockFace& look) {
+  constexpr const FaceTemplate& face = FACE_TEMPLATES[F];
+  const float px = static_cast<float>(x);
+  const float py = static_cast<float>(y);
+  const float pz = static_cast<float>(z);
+  const float layer = static_cast<float>(look.row * ATLAS_SIZE + look.col);
+
+  for (int corner = 0; corner < 4; corner++) {
+    Vertex& out = vertex[corner];
+    out.position[0] = px + face.corners[corner][0];
+    out.position[1] = py + face.corners[corner][1];
+    out.position[2] = pz + face.corners[corner][2];
+    out.normal[0] = face.normal[0];
+    out.normal[1] = face.normal[1];
+    out.normal[2] = face.normal[2];
+    out.uvLayer[0] = face.uvs[corner][0];
+    out.uvLayer[1] = face.uvs[corner][1];
+    out.uvLayer[2] = layer;
+    out.tint = look.tint;
+  }
+  for (int i = 0; i < 6; i++)
+    index[i] = baseVertex + QUAD_INDICES[i];
+}
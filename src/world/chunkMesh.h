@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../core/memory_stats.h"
+
+struct BlockFace;
+
+// Face directions. Meshes are stored as one contiguous index range per
+// direction, in this order.
+enum Face : uint8_t {
+  FACE_POS_X,
+  FACE_NEG_X,
+  FACE_POS_Y,
+  FACE_NEG_Y,
+  FACE_POS_Z,
+  FACE_NEG_Z,
+  FACE_COUNT
+};
+
+// CPU side of a chunk: its voxels and the mesh built from them. No GL here,
+// so generation and meshing run (and can be measured) without a context.
+class ChunkMesh {
+ public:
+  ChunkMesh(unsigned int chunkWidth,
+            unsigned int chunkHeight,
+            const std::vector<unsigned int>& chunkData);
+
+  void GenerateChunkTerrain();
+
+  // Rebuilds mesh using neighbor chunk data for correct border face culling.
+  // Pass nullptr for neighbors that don't exist (treated as air).
+  void GenerateChunkMesh(
+      const std::vector<unsigned int>* negX = nullptr,
+      const std::vector<unsigned int>* posX = nullptr,
+      const std::vector<unsigned int>* negZ = nullptr,
+      const std::vector<unsigned int>* posZ = nullptr);
+
+  const std::vector<unsigned int>& getData() const { return chunkData; }
+  unsigned int Width() const { return chunkWidth; }
+  unsigned int Height() const { return chunkHeight; }
+
+  // One corner of a face as uploaded, interleaved. The tint stays an integer
+  // all the way to the GPU; its packed bits aren't a safe float.
+  struct Vertex {
+    float position[3];
+    float normal[3];
+    float uvLayer[3];  // uv, texture array layer
+    uint32_t tint;     // RGBA8, see packTint
+  };
+
+  struct FaceBucket {
+    unsigned int firstIndex = 0;
+    unsigned int indexCount = 0;
+  };
+
+  // Empty after ReleaseMesh until the next GenerateChunkMesh. The buckets
+  // stay, so a drawn mesh still knows its index ranges.
+  const std::vector<Vertex>& Vertices() const { return vertices; }
+  const std::vector<unsigned int>& Indices() const { return indices; }
+  const std::array<FaceBucket, FACE_COUNT>& Buckets() const { return buckets; }
+
+  // Hands the vertex and index buffers back to this thread's pool once they
+  // are uploaded; the next mesh built on the thread reuses their capacity.
+  void ReleaseMesh();
+
+  // heap bytes held for the voxels and for the mesh
+  size_t VoxelBytes() const { return voxelMemory.bytes(); }
+  size_t MeshBytes() const { return meshMemory.bytes(); }
+
+ private:
+  // Writes one quad facing F: 4 vertices at vertex and 6 indices at index,
+  // the quad's first vertex being number baseVertex of the mesh.
+  template <Face F>
+  static void AddFace(Vertex* vertex,
+                      unsigned int* index,
+                      unsigned int baseVertex,
+                      int x,
+                      int y,
+                      int z,
+                      const BlockFace& look);
+
+  unsigned int chunkWidth;
+  unsigned int chunkHeight;
+  std::vector<std::vector<std::vector<uint8_t>>> blocks;
+  std::vector<unsigned int> chunkData;
+
+  std::array<FaceBucket, FACE_COUNT> buckets;
+  std::vector<Vertex> vertices;
+  std::vector<unsigned int> indices;
+
+  MemoryTracker voxelMemory{MEMORY_VOXELS};
+  MemoryTracker meshMemory{MEMORY_CPU_MESH};
+};
@@ -0,0 +1,242 @@
+// the one stb_image implementation, for everything linking cubicum_core
+#define STB_IMAGE_IMPLEMENTATION
+#include "terrain.h"
+#include "../core/trace.h"
+#include "perlinNoise.h"
+#include "stb_image/stb_image.h"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+Terrain::Terrain(int chunkSize, int chunkHeight)
+    : chunkSize(chunkSize), chunkHeight(chunkHeight) {}
+
+Terrain::~Terrain() {
+  if (heightmapData) {
+    stbi_image_free(heightmapData);
+  }
+}
+
+// Block type for a voxel at worldY in a column whose surface is at height.
+static unsigned int blockTypeAt(float worldY, float height) {
+  if (worldY > height)
+    return 0;  // air
+  if (worldY > height - 1)
+    return 1;  // grass
+  if (worldY > height - 5)
+    return 2;  // dirt
+  return 3;    // stone
+}
+
+float Terrain::Height(float worldX, float worldZ) {
+  if (heightmapData)
+    return SampleHeightmap(worldX, worldZ);
+
+  static PerlinNoise perlin;
+  float h = 0.0f;
+  float freq = 0.005f;
+  float amp  = 1.0f;
+  float maxAmp = 0.0f;
+  for (int octave = 0; octave < 7; ++octave) {
+    h += amp * perlin.noise(worldX * freq, worldZ * freq, 0.0f);
+    maxAmp += amp;
+    freq *= 2.0f;
+    amp  *= 0.4f;
+  }
+  h /= maxAmp;                   // normalize to [-1, 1]
+  h = (h + 1.0f) * 0.5f;        // remap to [0, 1]
+  // Plains below 0.4, hills/mountains above — tweak first value to taste
+  h = glm::smoothstep(0.35f, 0.75f, h);
+  float height = 8.0f + h * 52.0f;
+  return glm::clamp(height, 0.0f, static_cast<float>(chunkHeight - 1));
+}
+
+std::vector<unsigned int> Terrain::GenerateChunkData(int chunkX,
+                                                   int chunkY,
+                                                   int chunkZ) {
+  TRACE_ZONE("Terrain::GenerateChunkData");
+  std::vector<unsigned int> data;
+  data.reserve(chunkSize * chunkSize * chunkHeight);
+
+  static bool debugPrinted = false;
+  int blockCount = 0;
+  float minHeight = 999.0f, maxHeight = -999.0f;
+
+  // the terrain is a heightfield, so sample it once per column
+  std::vector<float> heights(chunkSize * chunkSize);
+  for (int z = 0; z < chunkSize; z++) {
+    for (int x = 0; x < chunkSize; x++) {
+      float worldX = chunkX * chunkSize + x;
+      float worldZ = chunkZ * chunkSize + z;
+      float height = Height(worldX, worldZ);
+      if (heightmapData) {
+        if (height < minHeight)
+          minHeight = height;
+        if (height > maxHeight)
+          maxHeight = height;
+      }
+      heights[x + z * chunkSize] = height;
+    }
+  }
+
+  // Layout matches Chunk index formula: x + y*W + z*W*H → iterate z outer, y mid, x inner
+  for (int z = 0; z < chunkSize; z++) {
+    for (int y = 0; y < chunkHeight; y++) {
+      for (int x = 0; x < chunkSize; x++) {
+        float worldY = chunkY * chunkHeight + y;
+        unsigned int blockType = blockTypeAt(worldY, heights[x + z * chunkSize]);
+        if (blockType != 0)
+          blockCount++;
+        data.push_back(blockType);
+      }
+    }
+  }
+
+  if (!debugPrinted && chunkX == 0 && chunkZ == 0) {
+    std::cout << "DEBUG Chunk(0,0,0):\n";
+    std::cout << "  Blocks generated: " << blockCount << "\n";
+    std::cout << "  Height range: [" << minHeight << ", " << maxHeight << "]\n";
+    std::cout << "  Sample 4x4 heights:\n";
+    for (int sx = 0; sx < 4; sx++) {
+      for (int sz = 0; sz < 4; sz++) {
+        float h =
+            SampleHeightmap(static_cast<float>(sx), static_cast<float>(sz));
+        std::cout << h << (sz == 3 ? "\n" : " ");
+      }
+    }
+    debugPrinted = true;
+  }
+
+  return data;
+}
+
+// Downsampled voxels for a LOD node. Each cell covers 2^level blocks in every
+// axis and takes its height from the center of its column.
+std::vector<unsigned int> Terrain::GenerateLodData(int level,
+                                                 int nodeX,
+                                                 int nodeZ) {
+  TRACE_ZONE("Terrain::GenerateLodData");
+  const int cell = 1 << level;
+  const int cellsHigh = chunkHeight / cell;
+  const float nodeSize = static_cast<float>(chunkSize * cell);
+
+  std::vector<float> heights(chunkSize * chunkSize);
+  for (int z = 0; z < chunkSize; z++) {
+    for (int x = 0; x < chunkSize; x++) {
+      float worldX = nodeX * nodeSize + (x + 0.5f) * cell;
+      float worldZ = nodeZ * nodeSize + (z + 0.5f) * cell;
+      heights[x + z * chunkSize] = Height(worldX, worldZ);
+    }
+  }
+
+  std::vector<unsigned int> data;
+  data.reserve(chunkSize * chunkSize * cellsHigh);
+  for (int z = 0; z < chunkSize; z++) {
+    for (int y = 0; y < cellsHigh; y++) {
+      for (int x = 0; x < chunkSize; x++) {
+        float height = heights[x + z * chunkSize];
+        float bottom = static_cast<float>(y * cell);
+        unsigned int blockType = 0;
+        if (bottom <= height) {
+          // the topmost cell of a column shows grass whatever its size
+          blockType = bottom + cell > height ? 1 : blockTypeAt(bottom, height);
+        }
+        data.push_back(blockType);
+      }
+    }
+  }
+  return data;
+}
+
+bool Terrain::LoadHeightmap(const char* path) {
+  int channels;
+  unsigned char* data =
+      stbi_load(path, &heightmapWidth, &heightmapHeight, &channels, 1);
+
+  if (!data) {
+    std::cerr << "Failed to load heightmap: " << path << "\n";
+    return false;
+  }
+
+  heightmapData = data;
+  heightmapMemory.set(static_cast<size_t>(heightmapWidth) * heightmapHeight);
+
+  // Debug: Check min/max values
+  unsigned char minVal = 255, maxVal = 0;
+  for (int i = 0; i < heightmapWidth * heightmapHeight; ++i) {
+    if (heightmapData[i] < minVal)
+      minVal = heightmapData[i];
+    if (heightmapData[i] > maxVal)
+      maxVal = heightmapData[i];
+  }
+  heightmapMin = static_cast<int>(minVal);
+  heightmapMax = static_cast<int>(maxVal);
+
+  std::cout << "Loaded heightmap: " << path << " (" << heightmapWidth << "x"
+            << heightmapHeight << ")\n";
+  std::cout << "  PNG values: min=" << (int)minVal << " max=" << (int)maxVal
+            << "\n";
+  return true;
+}
+
+float Terrain::SampleHeightmap(float worldX, float worldZ) {
+  if (!heightmapData || heightmapWidth == 0 || heightmapHeight == 0) {
+    return 0.0f;
+  }
+
+  // Muestreo directo del heightmap: cada pixel ~1 bloque
+  const float PIXEL_SCALE = 1.0f;
+  float u = worldX / PIXEL_SCALE;
+  float v = worldZ / PIXEL_SCALE;
+
+  // Wrap coordinates to repeat the heightmap seamlessly
+  u = std::fmod(u, static_cast<float>(heightmapWidth));
+  v = std::fmod(v, static_cast<float>(heightmapHeight));
+
+  if (u < 0)
+    u += heightmapWidth;
+  if (v < 0)
+    v += heightmapHeight;
+
+  // Bilinear interpolation
+  int x0 = static_cast<int>(u);
+  int z0 = static_cast<int>(v);
+  int x1 = (x0 + 1) % heightmapWidth;
+  int z1 = (z0 + 1) % heightmapHeight;
+
+  float fx = u - x0;  // fractional part
+  float fz = v - z0;
+
+  auto sampleNorm = [&](int px, int pz) {
+    unsigned char pv = heightmapData[pz * heightmapWidth + px];
+    int range = heightmapMax - heightmapMin;
+    float norm = 0.0f;
+    if (range > 0)
+      norm = (static_cast<int>(pv) - heightmapMin) / static_cast<float>(range);
+    return norm * HEIGHT_SCALE;
+  };
+
+  float h00 = sampleNorm(x0, z0);
+  float h10 = sampleNorm(x1, z0);
+  float h01 = sampleNorm(x0, z1);
+  float h11 = sampleNorm(x1, z1);
+
+  // Interpolación suavizada con smoothstep para reducir peldaños
+  auto smooth = [](float t) { return t * t * (3.0f - 2.0f * t); };
+  float sx = smooth(fx);
+  float sz = smooth(fz);
+
+  float h0 = h00 * (1.0f - sx) + h10 * sx;
+  float h1 = h01 * (1.0f - sx) + h11 * sx;
+  float height = h0 * (1.0f - sz) + h1 * sz;
+
+  if (height < 0.0f)
+    height = 0.0f;
+  if (height > chunkHeight - 1)
+    height = static_cast<float>(chunkHeight - 1);
+
+  return height;
+}
@@ -0,0 +1,47 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include <vector>
+
+#include "../core/memory_stats.h"
+
+// Voxel terrain generation: a heightfield from noise (or an optional
+// heightmap) turned into chunk and LOD node block data.
+class Terrain {
+ public:
+  Terrain(int chunkSize, int chunkHeight);
+  ~Terrain();
+
+  Terrain(const Terrain&) = delete;
+  Terrain& operator=(const Terrain&) = delete;
+
+  // Block ids laid out x + y*W + z*W*H, as Chunk and ChunkMesh expect.
+  std::vector<unsigned int> GenerateChunkData(int chunkX,
+                                              int chunkY,
+                                              int chunkZ);
+  std::vector<unsigned int> GenerateLodData(int level, int nodeX, int nodeZ);
+
+  // surface height of the terrain column at a world position
+  float Height(float worldX, float worldZ);
+
+  bool LoadHeightmap(const char* path);
+
+ private:
+  int chunkSize;
+  int chunkHeight;
+
+  // Heightmap data
+  unsigned char* heightmapData = nullptr;
+  int heightmapWidth = 0;
+  int heightmapHeight = 0;
+  const float HEIGHT_SCALE = 60.0f;  // Pixel [0,255] maps to height [0,60]
+
+  MemoryTracker heightmapMemory{MEMORY_CACHES};
+
+  int heightmapMin = 0;
+  int heightmapMax = 255;
+
+  float SampleHeightmap(float worldX, float worldZ);
+};
+
+#endif  // TERRAIN_H
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+
+// Atlas terrain.png: 256x256px, 16 columns x 16 rows, each cell 16px.
+// Loaded as a texture array, cell (col, row) is layer row * ATLAS_SIZE + col.
+static constexpr int ATLAS_SIZE = 16;
+
+// Color multiplier packed as RGBA8, red in the lowest byte. Meshes carry it
+// as an integer attribute and the vertex shader unpacks it.
+constexpr uint32_t packTint(uint8_t r, uint8_t g, uint8_t b) {
+  return r | (g << 8) | (b << 16) | (0xFFu << 24);
+}
+static constexpr uint32_t NO_TINT = 0xFFFFFFFF;
+
+// What one side of a block looks like: atlas cell + tint
+struct BlockFace {
+  uint8_t col;
+  uint8_t row;
+  uint32_t tint;
+};
+
+struct BlockType {
+  BlockFace top;
+  BlockFace side;
+  BlockFace bottom;
+};
+
+// Block registry, indexed by block id. Row 0 is the top row of the PNG
+// (v = 0..1/16 after vertical flip on load).
+static constexpr BlockType BLOCK_TYPES[] = {
+    // 0: air, never meshed
+    {{0, 0, NO_TINT}, {0, 0, NO_TINT}, {0, 0, NO_TINT}},
+    // 1: grass, the top cell is grey and gets tinted green
+    {{0, 0, packTint(184, 230, 128)}, {3, 0, NO_TINT}, {2, 0, NO_TINT}},
+    // 2: dirt
+    {{2, 0, NO_TINT}, {2, 0, NO_TINT}, {2, 0, NO_TINT}},
+    // 3: stone
+    {{1, 0, NO_TINT}, {1, 0, NO_TINT}, {1, 0, NO_TINT}},
+};
+static constexpr int BLOCK_TYPE_COUNT =
+    sizeof(BLOCK_TYPES) / sizeof(BLOCK_TYPES[0]);
+
+inline const BlockFace& getBlockFace(uint8_t blockType,
+                                     bool isTop,
+                                     bool isBottom) {
+  // unknown ids fall back to stone
+  const BlockType& type =
+      BLOCK_TYPES[blockType < BLOCK_TYPE_COUNT ? blockType : 3];
+  if (isTop)
+    return type.top;
+  if (isBottom)
+    return type.bottom;
+  return type.side;
+}
+
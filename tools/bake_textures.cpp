@@ -0,0 +1,58 @@
+// Offline texture baker. Decodes an atlas PNG once and writes it as a baked
+// texture array (see src/core/baked_texture.h) that the game can mmap and
+// upload without decoding or generating mips at startup.
+//
+//   bake_textures <atlas.png> <out.ctex> <cells per side>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "../src/core/baked_texture.h"
+
+int main(int argc, char** argv) {
+  if (argc != 4) {
+    std::cerr << "usage: " << argv[0]
+              << " <atlas.png> <out.ctex> <cells per side>\n";
+    return 1;
+  }
+  const char* inputPath = argv[1];
+  const char* outputPath = argv[2];
+  const int cellsPerSide = std::atoi(argv[3]);
+
+  stbi_set_flip_vertically_on_load(false);
+  int width, height, channels;
+  unsigned char* pixels = stbi_load(inputPath, &width, &height, &channels, 4);
+  if (!pixels) {
+    std::cerr << "couldnt load " << inputPath << " :c\n";
+    return 1;
+  }
+
+  std::vector<uint8_t> baked;
+  bool ok = bakeAtlas(pixels, width, height, cellsPerSide, baked);
+  stbi_image_free(pixels);
+  if (!ok) {
+    std::cerr << inputPath << " (" << width << "x" << height
+              << ") doesnt split into " << cellsPerSide << "x" << cellsPerSide
+              << " cells :c\n";
+    return 1;
+  }
+
+  std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+  if (!out.write(reinterpret_cast<const char*>(baked.data()), baked.size())) {
+    std::cerr << "couldnt write " << outputPath << " :c\n";
+    return 1;
+  }
+
+  const BakedTextureHeader* header =
+      readBakedTexture(baked.data(), baked.size());
+  std::cout << "Baked " << inputPath << " -> " << outputPath << ": "
+            << header->layers << " layers of " << header->width << "x"
+            << header->height << ", " << header->mipLevels << " mips, "
+            << baked.size() << " bytes\n";
+  return 0;
+}